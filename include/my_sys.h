@@ -791,6 +791,11 @@ extern my_bool radixsort_is_appliccable(uint n_items, size_t size_of_element);
 extern void my_string_ptr_sort(uchar *base,uint items,size_t size);
 extern void radixsort_for_str_ptr(uchar* base[], uint number_of_elements,
 				  size_t size_of_element,uchar *buffer[]);
+extern my_bool msd_radixsort_is_applicable(uint n_items,
+                                           size_t size_of_element);
+extern void msd_radixsort_for_str_ptr(uchar* base[], uint number_of_elements,
+                                      size_t size_of_element, uchar *buffer[],
+                                      uchar *digits);
 extern qsort_t my_qsort(void *base_ptr, size_t total_elems, size_t size,
                         qsort_cmp cmp);
 extern qsort_t my_qsort2(void *base_ptr, size_t total_elems, size_t size,
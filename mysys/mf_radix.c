@@ -58,3 +58,100 @@ void radixsort_for_str_ptr(uchar **base, uint number_of_elements, size_t size_of
   next:;
   }
 }
+
+
+/*
+  MSD radixsort for pointers to fixed length strings.
+
+  Used for long strings and large arrays, where the LSD radixsort above
+  would need too many passes over all elements. The elements are
+  distributed into 256 buckets by the byte at the current position,
+  then each bucket is sorted by the following bytes. A byte that is the
+  same for all elements of a bucket is skipped without moving anything.
+  Small buckets, and buckets left after too many levels of recursion,
+  are sorted by comparisons of the remaining bytes.
+
+  The byte of every element at the current position is read only once per
+  pass and cached in the array 'digits', so that the distribution pass does
+  not have to access the strings again.
+  Needs extra buffers of number_of_elements pointers and number_of_elements
+  bytes.
+*/
+
+/* Buckets with fewer elements are sorted by comparisons */
+#define MSD_RADIXSORT_MIN_ITEMS 64
+/* Max depth of recursion, deeper buckets are sorted by comparisons */
+#define MSD_RADIXSORT_MAX_LEVELS 32
+
+my_bool msd_radixsort_is_applicable(uint n_items, size_t size_of_element)
+{
+  return size_of_element > 0 && n_items >= 1000;
+}
+
+
+static int cmp_str_suffix(const void *cmp_arg, const void *a, const void *b)
+{
+  const size_t *arg= (const size_t*) cmp_arg;
+  return memcmp(*(uchar**) a + arg[0], *(uchar**) b + arg[0], arg[1]);
+}
+
+
+static void msd_radixsort(uchar **base, uint number_of_elements,
+                          size_t size_of_element, size_t pos, uint level,
+                          uchar **buffer, uchar *digits)
+{
+  uint32 count[256];
+  uint i, start;
+
+  while (pos < size_of_element)
+  {
+    if (number_of_elements < MSD_RADIXSORT_MIN_ITEMS ||
+        level >= MSD_RADIXSORT_MAX_LEVELS)
+    {
+      size_t arg[2];
+      arg[0]= pos;
+      arg[1]= size_of_element - pos;
+      my_qsort2(base, number_of_elements, sizeof(uchar*), cmp_str_suffix, arg);
+      return;
+    }
+
+    bzero((uchar*) count, sizeof(count));
+    for (i= 0; i < number_of_elements; i++)
+      count[digits[i]= base[i][pos]]++;
+
+    if (count[digits[0]] == number_of_elements)
+    {
+      /* All elements have the same byte at this position */
+      pos++;
+      continue;
+    }
+
+    /* Turn the counts into the ends of the buckets */
+    for (i= 1; i < 256; i++)
+      count[i]+= count[i-1];
+    for (i= number_of_elements; i-- > 0; )
+      buffer[--count[digits[i]]]= base[i];
+    memcpy(base, buffer, number_of_elements * sizeof(uchar*));
+
+    /* Now count[i] is the start of the bucket i */
+    for (i= 0; i < 256; i++)
+    {
+      uint end= i < 255 ? count[i+1] : number_of_elements;
+      start= count[i];
+      if (end - start > 1)
+        msd_radixsort(base + start, end - start, size_of_element, pos + 1,
+                      level + 1, buffer, digits);
+    }
+    return;
+  }
+}
+
+
+void msd_radixsort_for_str_ptr(uchar **base, uint number_of_elements,
+                               size_t size_of_element, uchar **buffer,
+                               uchar *digits)
+{
+  if (number_of_elements > 1)
+    msd_radixsort(base, number_of_elements, size_of_element, 0, 0,
+                  buffer, digits);
+}
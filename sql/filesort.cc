@@ -183,6 +183,8 @@ SORT_INFO *filesort(THD *thd, TABLE *table, Filesort *filesort,
                                      &multi_byte_charset),
                           table, max_rows, filesort->sort_positions);
 
+  param.max_sort_threads= (uint) thd->variables.max_sort_threads;
+
   sort->addon_buf=    param.addon_buf;
   sort->addon_field=  param.addon_field;
   sort->unpack=       unpack_addon_fields;
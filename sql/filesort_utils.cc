@@ -157,21 +157,217 @@ void Filesort_buffer::free_sort_buffer()
 }
 
 
+/*
+  The minimal number of keys sorted by one thread when the sort buffer
+  is sorted by several threads
+*/
+#define MIN_SORT_KEYS_PER_THREAD 16384
+
+namespace {
+/**
+  A part of the work done when the sort buffer is sorted by several threads:
+  either sorting of a part of the buffer, or merging of two adjacent
+  sorted parts of it.
+*/
+struct Sort_buffer_task
+{
+  uchar **keys;               // The part to sort or the first part to merge
+  uint count;
+  uchar **keys2;              // The second part to merge, NULL for sorting
+  uint count2;
+  uchar **to;                 // The radix sort buffer or the merge target
+  uchar *digits;              // The byte cache for MSD radix sort
+  size_t sort_length;
+  pthread_t thread;
+  bool thread_started;
+};
+
+
+/**
+  Sort an array of pointers to keys
+
+  @param keys     The pointers to the keys to sort
+  @param count    The number of keys
+  @param size     The length of the keys
+  @param buffer   The buffer for count pointers, or NULL
+  @param digits   The buffer for count bytes, or NULL
+
+  @details
+    The keys built by make_sortkey() are compared by memcmp(), so
+    they can be sorted by radix sort. Short keys are sorted by LSD
+    radix sort, long keys by MSD radix sort. Without buffers, or when
+    there are too few keys, the comparison sort is used.
+*/
+
+void sort_keys(uchar **keys, uint count, size_t size, uchar **buffer,
+               uchar *digits)
+{
+  if (count <= 1)
+    return;
+  if (buffer && radixsort_is_appliccable(count, size))
+  {
+    radixsort_for_str_ptr(keys, count, size, buffer);
+    return;
+  }
+  if (buffer && digits && msd_radixsort_is_applicable(count, size))
+  {
+    msd_radixsort_for_str_ptr(keys, count, size, buffer, digits);
+    return;
+  }
+  my_qsort2(keys, count, sizeof(uchar*), get_ptr_compare(size), &size);
+}
+
+
+void merge_keys(uchar **keys, uint count, uchar **keys2, uint count2,
+                uchar **to, size_t size)
+{
+  uchar **end= keys + count, **end2= keys2 + count2;
+  while (keys < end && keys2 < end2)
+  {
+    if (memcmp(*keys2, *keys, size) < 0)
+      *to++= *keys2++;
+    else
+      *to++= *keys++;
+  }
+  memcpy(to, keys, (end - keys) * sizeof(uchar*));
+  to+= end - keys;
+  memcpy(to, keys2, (end2 - keys2) * sizeof(uchar*));
+}
+
+
+void run_sort_buffer_task(Sort_buffer_task *task)
+{
+  if (task->keys2)
+    merge_keys(task->keys, task->count, task->keys2, task->count2,
+               task->to, task->sort_length);
+  else
+    sort_keys(task->keys, task->count, task->sort_length, task->to,
+              task->digits);
+}
+
+
+extern "C" void *sort_buffer_thread(void *arg)
+{
+  my_thread_init();
+  run_sort_buffer_task((Sort_buffer_task*) arg);
+  my_thread_end();
+  return 0;
+}
+
+
+/**
+  Run the tasks, each of them in its own thread.
+  The first task is run by the calling thread. If a thread can't be
+  created its task is run by the calling thread as well.
+*/
+void run_sort_buffer_tasks(Sort_buffer_task *tasks, uint n_tasks)
+{
+  for (uint i= 1; i < n_tasks; i++)
+    tasks[i].thread_started=
+      !mysql_thread_create(0, /* Not instrumented */
+                           &tasks[i].thread, NULL, sort_buffer_thread,
+                           &tasks[i]);
+  run_sort_buffer_task(&tasks[0]);
+  for (uint i= 1; i < n_tasks; i++)
+  {
+    if (tasks[i].thread_started)
+      pthread_join(tasks[i].thread, NULL);
+    else
+      run_sort_buffer_task(&tasks[i]);
+  }
+}
+}
+
+
+/**
+  Sort the sort buffer using several threads
+
+  @param keys        The pointers to the keys to sort
+  @param count       The number of keys
+  @param size        The length of the keys
+  @param buffer      The buffer for count pointers
+  @param digits      The buffer for count bytes
+  @param n_threads   The number of threads to use
+
+  @details
+    The array of pointers is divided into n_threads parts that are sorted
+    in parallel. Then the sorted parts are merged pairwise: the merges of
+    each round are performed in parallel, the array of pointers and
+    the buffer are used by turns as the source and the target of a round.
+    Each part keeps its position in the array, so merging of two adjacent
+    parts gives a part occupying the same positions in the target.
+*/
+
+static void sort_buffer_parallel(uchar **keys, uint count, size_t size,
+                                 uchar **buffer, uchar *digits,
+                                 uint n_threads)
+{
+  Sort_buffer_task tasks[64];
+  uint start[64 + 1];
+  DBUG_ASSERT(n_threads > 1 && n_threads <= array_elements(tasks));
+
+  for (uint i= 0; i <= n_threads; i++)
+    start[i]= (uint) ((ulonglong) count * i / n_threads);
+
+  for (uint i= 0; i < n_threads; i++)
+  {
+    Sort_buffer_task *task= &tasks[i];
+    task->keys= keys + start[i];
+    task->count= start[i + 1] - start[i];
+    task->keys2= NULL;
+    task->count2= 0;
+    task->to= buffer + start[i];
+    task->digits= digits + start[i];
+    task->sort_length= size;
+  }
+  run_sort_buffer_tasks(tasks, n_threads);
+
+  uchar **from= keys, **to= buffer;
+  for (uint n_parts= n_threads; n_parts > 1; n_parts= (n_parts + 1) / 2)
+  {
+    uint n_tasks= 0;
+    for (uint i= 0; i < n_parts; i+= 2, n_tasks++)
+    {
+      /* The last part is copied as it is when the number of parts is odd */
+      uint end= i + 2 <= n_parts ? start[i + 2] : start[i + 1];
+      Sort_buffer_task *task= &tasks[n_tasks];
+      task->keys= from + start[i];
+      task->count= start[i + 1] - start[i];
+      task->keys2= from + start[i + 1];
+      task->count2= end - start[i + 1];
+      task->to= to + start[i];
+      task->sort_length= size;
+      start[n_tasks]= start[i];
+    }
+    start[n_tasks]= count;
+    run_sort_buffer_tasks(tasks, n_tasks);
+    swap_variables(uchar**, from, to);
+  }
+
+  if (from != keys)
+    memcpy(keys, from, count * sizeof(uchar*));
+}
+
+
 void Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
 {
   size_t size= param->sort_length;
   if (count <= 1 || size == 0)
     return;
   uchar **keys= get_sort_keys();
+  uint n_threads= MY_MIN(param->max_sort_threads,
+                         count / MIN_SORT_KEYS_PER_THREAD);
+  /* The buffer for the radix sorts and the merges of sorted parts */
   uchar **buffer= NULL;
-  if (radixsort_is_appliccable(count, param->sort_length) &&
-      (buffer= (uchar**) my_malloc(count*sizeof(char*),
-                                   MYF(MY_THREAD_SPECIFIC))))
-  {
-    radixsort_for_str_ptr(keys, count, param->sort_length, buffer);
-    my_free(buffer);
-    return;
-  }
-  
-  my_qsort2(keys, count, sizeof(uchar*), get_ptr_compare(size), &size);
+  if (n_threads > 1 || radixsort_is_appliccable(count, size) ||
+      msd_radixsort_is_applicable(count, size))
+    buffer= (uchar**) my_malloc(count * (sizeof(uchar*) + 1),
+                                MYF(MY_THREAD_SPECIFIC));
+  uchar *digits= buffer ? (uchar*) (buffer + count) : NULL;
+
+  if (n_threads > 1 && buffer)
+    sort_buffer_parallel(keys, count, size, buffer, digits, n_threads);
+  else
+    sort_keys(keys, count, size, buffer, digits);
+  my_free(buffer);
 }
@@ -3824,6 +3824,14 @@ class handler :public Sql_alloc
   */
   virtual void try_semi_consistent_read(bool) {}
   virtual void unlock_row() {}
+  /**
+    Tell the engine that a row with the given key value will soon be read
+    from the given index. The engine may start reading the index pages
+    that contain it in the background, without waiting for the read.
+    This is only a hint, and nothing is returned.
+  */
+  virtual void prefetch_index_read(uint index, const uchar *key,
+                                   uint key_len) {}
   virtual int start_stmt(THD *thd, thr_lock_type lock_type) {return 0;}
   virtual bool need_info_for_auto_inc() { return 0; }
   virtual bool can_use_for_auto_inc_init() { return 1; }
@@ -104,6 +104,7 @@ ulong opt_binlog_dbug_fsync_sleep= 0;
 
 mysql_mutex_t LOCK_prepare_ordered;
 mysql_cond_t COND_prepare_ordered;
+mysql_mutex_t LOCK_binlog_sync;
 mysql_mutex_t LOCK_after_binlog_sync;
 mysql_mutex_t LOCK_commit_ordered;
 
@@ -2432,6 +2433,136 @@ File open_binlog(IO_CACHE *log, const char *log_file_name, const char **errmsg)
   DBUG_RETURN(-1);
 }
 
+
+/*
+  Format of the GTID index file <binlog name>.gtid_index, all integers
+  are little-endian:
+
+    4 bytes  magic
+    4 bytes  format version
+    8 bytes  size of the binlog file that is indexed
+    4 bytes  number of entries
+  followed by the entries, each one
+    8 bytes  offset in the binlog file
+    4 bytes  number N of GTIDs in the binlog state at that offset
+    N times  4 bytes domain_id, 4 bytes server_id, 8 bytes seq_no
+  followed by a 4 byte checksum of everything before it.
+*/
+static const char gtid_index_ext[]= ".gtid_index";
+static const uchar gtid_index_magic[4]= { 0xfe, 'g', 'i', 'x' };
+static const uint32 GTID_INDEX_VERSION= 1;
+static const size_t GTID_INDEX_HEADER_SIZE= 20;
+static const size_t GTID_INDEX_ENTRY_SIZE= 12;
+static const size_t GTID_INDEX_GTID_SIZE= 16;
+
+
+static void gtid_index_name(char *buf, const char *log_file_name)
+{
+  strxnmov(buf, FN_REFLEN - 1, log_file_name, gtid_index_ext, NullS);
+}
+
+
+/* Delete the GTID index of a binlog file that is being deleted, if any. */
+static void delete_gtid_index(const char *log_file_name)
+{
+  char buf[FN_REFLEN];
+  gtid_index_name(buf, log_file_name);
+  mysql_file_delete(key_file_binlog_gtid_index, buf, MYF(0));
+}
+
+
+/*
+  Read the GTID index of a binlog file.
+
+  @param log_file_name  Full name of the binlog file
+  @param log_size       Current size of the binlog file. An index written
+                        for a different file of the same name is ignored.
+
+  @return false if the index was read, true if there is no usable index.
+*/
+bool Binlog_gtid_index::read(const char *log_file_name, my_off_t log_size)
+{
+  char buf[FN_REFLEN];
+  File file_no;
+  uchar *data= NULL;
+  const uchar *p, *end;
+  rpl_gtid *gtid;
+  my_off_t size;
+  size_t total= 0;
+  uint32 i, j;
+  bool err= true;
+  DBUG_ENTER("Binlog_gtid_index::read");
+
+  gtid_index_name(buf, log_file_name);
+  if ((file_no= mysql_file_open(key_file_binlog_gtid_index, buf,
+                                O_RDONLY | O_BINARY | O_SHARE, MYF(0))) < 0)
+    DBUG_RETURN(true);
+  size= mysql_file_seek(file_no, 0, MY_SEEK_END, MYF(0));
+  if (size >= GTID_INDEX_HEADER_SIZE + 4 && size < SIZE_T_MAX &&
+      (data= (uchar *) my_malloc((size_t) size, MYF(MY_WME))) &&
+      mysql_file_seek(file_no, 0, MY_SEEK_SET, MYF(0)) == 0 &&
+      !mysql_file_read(file_no, data, (size_t) size, MYF(MY_NABP)))
+    err= false;
+  mysql_file_close(file_no, MYF(0));
+  if (err)
+    goto end;
+
+  err= true;
+  end= data + size - 4;
+  if (memcmp(data, gtid_index_magic, sizeof(gtid_index_magic)) ||
+      uint4korr(data + 4) != GTID_INDEX_VERSION ||
+      uint8korr(data + 8) != log_size ||
+      uint4korr(end) != my_checksum(0, data, end - data))
+    goto end;
+  count= uint4korr(data + 16);
+
+  /* Validate the entries and count the GTIDs in them. */
+  p= data + GTID_INDEX_HEADER_SIZE;
+  for (i= 0; i < count; i++)
+  {
+    if ((size_t) (end - p) < GTID_INDEX_ENTRY_SIZE ||
+        uint8korr(p) > log_size)
+      goto end;
+    uint32 n= uint4korr(p + 8);
+    p+= GTID_INDEX_ENTRY_SIZE;
+    if ((size_t) (end - p) / GTID_INDEX_GTID_SIZE < n)
+      goto end;
+    p+= n * GTID_INDEX_GTID_SIZE;
+    total+= n;
+  }
+  if (p != end ||
+      !(mem= my_malloc(count * (sizeof(*offsets) + sizeof(*lists) +
+                                sizeof(*list_lens)) +
+                       total * sizeof(rpl_gtid) + 1, MYF(MY_WME))))
+    goto end;
+
+  offsets= static_cast<my_off_t*>(mem);
+  lists= reinterpret_cast<rpl_gtid**>(offsets + count);
+  gtid= reinterpret_cast<rpl_gtid*>(lists + count);
+  list_lens= reinterpret_cast<uint32*>(gtid + total);
+  p= data + GTID_INDEX_HEADER_SIZE;
+  for (i= 0; i < count; i++)
+  {
+    offsets[i]= uint8korr(p);
+    list_lens[i]= uint4korr(p + 8);
+    lists[i]= gtid;
+    p+= GTID_INDEX_ENTRY_SIZE;
+    for (j= 0; j < list_lens[i]; j++, gtid++, p+= GTID_INDEX_GTID_SIZE)
+    {
+      gtid->domain_id= uint4korr(p);
+      gtid->server_id= uint4korr(p + 4);
+      gtid->seq_no= uint8korr(p + 8);
+    }
+  }
+  err= false;
+
+end:
+  my_free(data);
+  if (err)
+    count= 0;
+  DBUG_RETURN(err);
+}
+
 #ifdef _WIN32
 static int eventSource = 0;
 
@@ -3244,6 +3375,7 @@ MYSQL_BIN_LOG::MYSQL_BIN_LOG(uint *sync_period)
    group_commit_trigger_lock_wait(0),
    sync_period_ptr(sync_period), sync_counter(0),
    state_file_deleted(false), binlog_state_recover_done(false),
+   gtid_index_count(0), gtid_index_last_offset(0),
    is_relay_log(0), relay_signal_cnt(0),
    checksum_alg_reset(BINLOG_CHECKSUM_ALG_UNDEF),
    relay_log_checksum_alg(BINLOG_CHECKSUM_ALG_UNDEF),
@@ -3293,6 +3425,7 @@ void MYSQL_BIN_LOG::cleanup()
     mysql_mutex_lock(&LOCK_log);
     close(LOG_CLOSE_INDEX|LOG_CLOSE_STOP_EVENT);
     mysql_mutex_unlock(&LOCK_log);
+    gtid_index.free();
     delete description_event_for_queue;
     delete description_event_for_exec;
 
@@ -3655,6 +3788,11 @@ bool MYSQL_BIN_LOG::open(const char *log_name,
         if (write_event(&gl_ev))
           goto err;
 
+        /* Start a new GTID index for the new binlog file. */
+        gtid_index.length(0);
+        gtid_index_count= 0;
+        gtid_index_last_offset= my_b_tell(&log_file);
+
         /* Output a binlog checkpoint event at the start of the binlog file. */
 
         /*
@@ -4238,6 +4376,8 @@ bool MYSQL_BIN_LOG::reset_logs(THD *thd, bool create_new_log,
 
   for (;;)
   {
+    if (!is_relay_log)
+      delete_gtid_index(linfo.log_file_name);
     if (unlikely((error= my_delete(linfo.log_file_name, MYF(0)))))
     {
       if (my_errno == ENOENT) 
@@ -4851,6 +4991,8 @@ int MYSQL_BIN_LOG::purge_index_entry(THD *thd, ulonglong *reclaimed_space,
         error= 0;
 
         DBUG_PRINT("info",("purging %s",log_info.log_file_name));
+        if (!is_relay_log)
+          delete_gtid_index(log_info.log_file_name);
         if (!my_delete(log_info.log_file_name, MYF(0)))
         {
           if (reclaimed_space)
@@ -5199,6 +5341,8 @@ int MYSQL_BIN_LOG::new_file_impl()
     DBUG_RETURN(error);
   }
 
+  /* A group commit may still be syncing the file. */
+  wait_for_binlog_sync();
   mysql_mutex_lock(&LOCK_index);
 
   /* Reuse old name if not binlog and not update log */
@@ -5388,6 +5532,7 @@ bool MYSQL_BIN_LOG::append_no_lock(Log_event* ev)
   }
   bytes_written+= ev->data_written;
   DBUG_PRINT("info",("max_size: %lu",max_size));
+  wait_for_binlog_sync();
   if (flush_and_sync(0))
     goto err;
   if (my_b_append_tell(&log_file) > max_size)
@@ -5447,6 +5592,7 @@ bool MYSQL_BIN_LOG::write_event_buffer(uchar* buf, uint len)
 
   error= 0;
   DBUG_PRINT("info",("max_size: %lu",max_size));
+  wait_for_binlog_sync();
   if (flush_and_sync(0))
     goto err;
   if (my_b_append_tell(&log_file) > max_size)
@@ -5460,9 +5606,21 @@ bool MYSQL_BIN_LOG::write_event_buffer(uchar* buf, uint len)
 
 bool MYSQL_BIN_LOG::flush_and_sync(bool *synced)
 {
-  int err=0, fd=log_file.file;
+  bool need_sync;
   if (synced)
     *synced= 0;
+  if (flush_for_sync(&need_sync))
+    return 1;
+  if (!need_sync)
+    return 0;
+  if (synced)
+    *synced= 1;
+  return sync_binlog_file(log_file.file);
+}
+
+bool MYSQL_BIN_LOG::flush_for_sync(bool *need_sync)
+{
+  *need_sync= false;
   mysql_mutex_assert_owner(&LOCK_log);
   if (flush_io_cache(&log_file))
     return 1;
@@ -5470,17 +5628,46 @@ bool MYSQL_BIN_LOG::flush_and_sync(bool *synced)
   if (sync_period && ++sync_counter >= sync_period)
   {
     sync_counter= 0;
-    err= mysql_file_sync(fd, MYF(MY_WME|MY_SYNC_FILESIZE));
-    if (synced)
-      *synced= 1;
+    *need_sync= true;
+  }
+  return 0;
+}
+
+/**
+  Synchronize the log file to disk, after flush_for_sync().
+
+  The group commit leader calls this without holding LOCK_log, in which
+  case it must hold LOCK_binlog_sync, so that the file is not closed
+  meanwhile.
+*/
+int MYSQL_BIN_LOG::sync_binlog_file(File fd)
+{
+  int err= mysql_file_sync(fd, MYF(MY_WME|MY_SYNC_FILESIZE));
 #ifndef DBUG_OFF
-    if (opt_binlog_dbug_fsync_sleep > 0)
-      my_sleep(opt_binlog_dbug_fsync_sleep);
+  if (opt_binlog_dbug_fsync_sleep > 0)
+    my_sleep(opt_binlog_dbug_fsync_sleep);
 #endif
-  }
   return err;
 }
 
+/**
+  Wait for a group commit that is in the sync stage to complete it.
+
+  Must be called with LOCK_log held, so that no other group commit can
+  enter the sync stage before the caller releases LOCK_log. Every writer
+  other than the group commit leader calls this before it moves
+  binlog_end_pos, so that binlog_end_pos never covers a group that has
+  not been synced yet.
+*/
+void MYSQL_BIN_LOG::wait_for_binlog_sync()
+{
+  mysql_mutex_assert_owner(&LOCK_log);
+  if (is_relay_log)
+    return;
+  mysql_mutex_lock(&LOCK_binlog_sync);
+  mysql_mutex_unlock(&LOCK_binlog_sync);
+}
+
 void MYSQL_BIN_LOG::start_union_events(THD *thd, query_id_t query_id_param)
 {
   DBUG_ASSERT(!thd->binlog_evt_union.do_union);
@@ -6140,6 +6327,101 @@ MYSQL_BIN_LOG::write_state_to_file()
 }
 
 
+/*
+  Add an entry to the GTID index of the current binlog file, recording the
+  binlog state at offset, which must be the end of an event group.
+
+  The entries are kept in memory and written to the GTID index file by
+  write_gtid_index() when the binlog file is closed. A slave connecting with
+  GTID can then start reading the binlog file near its position, see
+  gtid_find_binlog_file(), rather than from the start of the file.
+*/
+void
+MYSQL_BIN_LOG::gtid_index_add(my_off_t offset)
+{
+  rpl_gtid *list;
+  uint32 count, i;
+
+  mysql_mutex_assert_owner(&LOCK_log);
+  count= rpl_global_gtid_binlog_state.count();
+  if (!(list= (rpl_gtid *) my_malloc(count * sizeof(*list) + (count == 0),
+                                     MYF(MY_WME))))
+    return;
+  if (!rpl_global_gtid_binlog_state.get_gtid_list(list, count) &&
+      !gtid_index.reserve(GTID_INDEX_ENTRY_SIZE + count * GTID_INDEX_GTID_SIZE,
+                          MY_MAX(gtid_index.alloced_length(), IO_SIZE)))
+  {
+    uchar *p= (uchar *) gtid_index.ptr() + gtid_index.length();
+    int8store(p, offset);
+    int4store(p + 8, count);
+    p+= GTID_INDEX_ENTRY_SIZE;
+    for (i= 0; i < count; i++, p+= GTID_INDEX_GTID_SIZE)
+    {
+      int4store(p, list[i].domain_id);
+      int4store(p + 4, list[i].server_id);
+      int8store(p + 8, list[i].seq_no);
+    }
+    gtid_index.length((uint32) (p - (uchar *) gtid_index.ptr()));
+    gtid_index_count++;
+    gtid_index_last_offset= offset;
+  }
+  my_free(list);
+}
+
+
+/*
+  Write the GTID index of the binlog file that is being closed.
+
+  The index is written only if it has any entries, that is, if the binlog
+  file is larger than binlog_gtid_index_span.
+*/
+int
+MYSQL_BIN_LOG::write_gtid_index()
+{
+  File file_no;
+  char buf[FN_REFLEN];
+  uchar header[GTID_INDEX_HEADER_SIZE], trailer[4];
+  int err= 1;
+
+  mysql_mutex_assert_owner(&LOCK_log);
+  if (!gtid_index_count)
+    return 0;
+
+  memcpy(header, gtid_index_magic, sizeof(gtid_index_magic));
+  int4store(header + 4, GTID_INDEX_VERSION);
+  int8store(header + 8, my_b_tell(&log_file));
+  int4store(header + 16, gtid_index_count);
+  int4store(trailer, my_checksum(my_checksum(0, header, sizeof(header)),
+                                 (const uchar *) gtid_index.ptr(),
+                                 gtid_index.length()));
+
+  gtid_index_name(buf, log_file_name);
+  if ((file_no= mysql_file_open(key_file_binlog_gtid_index, buf,
+                                O_WRONLY|O_CREAT|O_TRUNC|O_BINARY,
+                                MYF(MY_WME))) >= 0)
+  {
+    err= mysql_file_write(file_no, header, sizeof(header),
+                          MYF(MY_WME|MY_NABP)) ||
+      mysql_file_write(file_no, (const uchar *) gtid_index.ptr(),
+                       gtid_index.length(), MYF(MY_WME|MY_NABP)) ||
+      mysql_file_write(file_no, trailer, sizeof(trailer),
+                       MYF(MY_WME|MY_NABP)) ||
+      mysql_file_sync(file_no, MYF(MY_WME));
+    mysql_file_close(file_no, MYF(0));
+  }
+  if (err)
+  {
+    /* Slaves will just scan the binlog file. */
+    sql_print_warning("Error writing GTID index file '%s'.", buf);
+    mysql_file_delete(key_file_binlog_gtid_index, buf, MYF(0));
+  }
+
+  gtid_index.length(0);
+  gtid_index_count= 0;
+  return err;
+}
+
+
 /*
   Initialize the binlog state from the master-bin.state file, at server startup.
 
@@ -6508,6 +6790,11 @@ bool MYSQL_BIN_LOG::write(Log_event *event_info, my_bool *with_annotate)
       {
         bool synced;
 
+        /*
+          Let a group commit in the sync stage finish first, so that the
+          hooks see the transactions in binlog order.
+        */
+        wait_for_binlog_sync();
         if ((error= flush_and_sync(&synced)))
         {
         }
@@ -7257,6 +7544,7 @@ bool MYSQL_BIN_LOG::write_incident(THD *thd)
   if (likely(is_open()))
   {
     prev_binlog_id= current_binlog_id;
+    wait_for_binlog_sync();
     if (likely(!(error= write_incident_already_locked(thd))) &&
         likely(!(error= flush_and_sync(0))))
     {
@@ -7299,6 +7587,7 @@ MYSQL_BIN_LOG::write_binlog_checkpoint_event_already_locked(const char *name_arg
     Otherwise a subsequent log purge could delete binlogs that XA recovery
     thinks are needed (even though they are not really).
   */
+  wait_for_binlog_sync();
   if (!write_event(&ev) && !flush_and_sync(0))
   {
     update_binlog_end_pos();
@@ -7881,6 +8170,8 @@ MYSQL_BIN_LOG::trx_group_commit_leader(group_commit_entry *leader)
   group_commit_entry *current, *last_in_queue;
   group_commit_entry *queue= NULL;
   bool check_purge= false;
+  /* whether LOCK_log was released for syncing the binlog */
+  bool in_sync_stage= false;
   ulong UNINIT_VAR(binlog_id);
   uint64 commit_id;
   DBUG_ENTER("MYSQL_BIN_LOG::trx_group_commit_leader");
@@ -7971,6 +8262,9 @@ MYSQL_BIN_LOG::trx_group_commit_leader(group_commit_entry *leader)
       strmake_buf(cache_mngr->last_commit_pos_file, log_file_name);
       commit_offset= my_b_write_tell(&log_file);
       cache_mngr->last_commit_pos_offset= commit_offset;
+      if (opt_binlog_gtid_index_span && likely(!current->error) &&
+          commit_offset >= gtid_index_last_offset + opt_binlog_gtid_index_span)
+        gtid_index_add(commit_offset);
       if (cache_mngr->using_xa && cache_mngr->xa_xid)
       {
         /*
@@ -7993,8 +8287,40 @@ MYSQL_BIN_LOG::trx_group_commit_leader(group_commit_entry *leader)
     }
     set_current_thd(leader->thd);
 
-    bool synced= 0;
-    if (unlikely(flush_and_sync(&synced)))
+    bool need_sync;
+    const File fd= log_file.file;
+    bool error= flush_for_sync(&need_sync);
+
+    /*
+      Wait for the previous group to leave the sync stage, so that the
+      hooks below and binlog_end_pos see the groups in binlog order.
+    */
+    DEBUG_SYNC(leader->thd, "commit_before_get_LOCK_binlog_sync");
+    mysql_mutex_lock(&LOCK_binlog_sync);
+
+    if (!error && need_sync && my_b_tell(&log_file) < (my_off_t) max_size)
+    {
+      /*
+        Sync the binlog in the sync stage, without holding LOCK_log, so
+        that the next group can write to the binlog meanwhile. This is
+        not possible if we are going to rotate the binlog, as rotate()
+        must not close the file that we are syncing.
+      */
+      if (xid_count > 0)
+        mark_xids_active(binlog_id, xid_count);
+      in_sync_stage= true;
+      mysql_mutex_unlock(&LOCK_log);
+      DEBUG_SYNC(leader->thd, "commit_after_release_LOCK_log_for_sync");
+      error= sync_binlog_file(fd);
+    }
+    else
+    {
+      mysql_mutex_unlock(&LOCK_binlog_sync);
+      if (!error && need_sync)
+        error= sync_binlog_file(fd);
+    }
+
+    if (unlikely(error))
     {
       for (current= queue; current != NULL; current= current->next)
       {
@@ -8011,7 +8337,10 @@ MYSQL_BIN_LOG::trx_group_commit_leader(group_commit_entry *leader)
       bool any_error= false;
 
       mysql_mutex_assert_not_owner(&LOCK_prepare_ordered);
-      mysql_mutex_assert_owner(&LOCK_log);
+      if (in_sync_stage)
+        mysql_mutex_assert_owner(&LOCK_binlog_sync);
+      else
+        mysql_mutex_assert_owner(&LOCK_log);
       mysql_mutex_assert_not_owner(&LOCK_after_binlog_sync);
       mysql_mutex_assert_not_owner(&LOCK_commit_ordered);
 
@@ -8040,55 +8369,69 @@ MYSQL_BIN_LOG::trx_group_commit_leader(group_commit_entry *leader)
         semi-sync might not have put the transaction into
         it's list before dump-thread tries to send it
       */
-      update_binlog_end_pos(commit_offset);
+      if (in_sync_stage)
+        update_binlog_end_pos_after_sync(commit_offset);
+      else
+        update_binlog_end_pos(commit_offset);
 
       if (unlikely(any_error))
         sql_print_error("Failed to run 'after_flush' hooks");
     }
 
     /*
-      If any commit_events are Xid_log_event, increase the number of pending
-      XIDs in current binlog (it's decreased in ::unlog()). When the count in
-      a (not active) binlog file reaches zero, we know that it is no longer
-      needed in XA recovery, and we can log a new binlog checkpoint event.
+      In the sync stage, the XIDs were marked active before releasing
+      LOCK_log, and the binlog did not need to be rotated.
     */
-    if (xid_count > 0)
-    {
-      mark_xids_active(binlog_id, xid_count);
-    }
-
-    if (rotate(false, &check_purge))
+    if (!in_sync_stage)
     {
       /*
-        If we fail to rotate, which thread should get the error?
-        We give the error to the leader, as any my_error() thrown inside
-        rotate() will have been registered for the leader THD.
+        If any commit_events are Xid_log_event, increase the number of pending
+        XIDs in current binlog (it's decreased in ::unlog()). When the count in
+        a (not active) binlog file reaches zero, we know that it is no longer
+        needed in XA recovery, and we can log a new binlog checkpoint event.
+      */
+      if (xid_count > 0)
+      {
+        mark_xids_active(binlog_id, xid_count);
+      }
 
-        However we must not return error from here - that would cause
-        ha_commit_trans() to abort and rollback the transaction, which would
-        leave an inconsistent state with the transaction committed in the
-        binlog but rolled back in the engine.
+      if (rotate(false, &check_purge))
+      {
+        /*
+          If we fail to rotate, which thread should get the error?
+          We give the error to the leader, as any my_error() thrown inside
+          rotate() will have been registered for the leader THD.
 
-        Instead set a flag so that we can return error later, from unlog(),
-        when the transaction has been safely committed in the engine.
-      */
-      leader->cache_mngr->delayed_error= true;
-      my_error(ER_ERROR_ON_WRITE, MYF(ME_ERROR_LOG), name, errno);
-      check_purge= false;
+          However we must not return error from here - that would cause
+          ha_commit_trans() to abort and rollback the transaction, which would
+          leave an inconsistent state with the transaction committed in the
+          binlog but rolled back in the engine.
+
+          Instead set a flag so that we can return error later, from unlog(),
+          when the transaction has been safely committed in the engine.
+        */
+        leader->cache_mngr->delayed_error= true;
+        my_error(ER_ERROR_ON_WRITE, MYF(ME_ERROR_LOG), name, errno);
+        check_purge= false;
+      }
+      /* In case of binlog rotate, update the correct current binlog offset. */
+      commit_offset= my_b_write_tell(&log_file);
     }
-    /* In case of binlog rotate, update the correct current binlog offset. */
-    commit_offset= my_b_write_tell(&log_file);
   }
 
   DEBUG_SYNC(leader->thd, "commit_before_get_LOCK_after_binlog_sync");
   mysql_mutex_lock(&LOCK_after_binlog_sync);
   /*
-    We cannot unlock LOCK_log until we have locked LOCK_after_binlog_sync;
-    otherwise scheduling could allow the next group commit to run ahead of us,
+    We cannot unlock LOCK_log (or LOCK_binlog_sync if we released LOCK_log
+    already) until we have locked LOCK_after_binlog_sync; otherwise
+    scheduling could allow the next group commit to run ahead of us,
     messing up the order of commit_ordered() calls. But as soon as
     LOCK_after_binlog_sync is obtained, we can let the next group commit start.
   */
-  mysql_mutex_unlock(&LOCK_log);
+  if (in_sync_stage)
+    mysql_mutex_unlock(&LOCK_binlog_sync);
+  else
+    mysql_mutex_unlock(&LOCK_log);
 
   DEBUG_SYNC(leader->thd, "commit_after_release_LOCK_log");
 
@@ -8493,6 +8836,8 @@ void MYSQL_BIN_LOG::close(uint exiting)
   if (log_state == LOG_OPENED)
   {
     DBUG_ASSERT(log_type == LOG_BIN);
+    /* A group commit may still be syncing the file. */
+    wait_for_binlog_sync();
 #ifdef HAVE_REPLICATION
     if (exiting & LOG_CLOSE_STOP_EVENT)
     {
@@ -8530,6 +8875,9 @@ void MYSQL_BIN_LOG::close(uint exiting)
     }
 #endif /* HAVE_REPLICATION */
 
+    if (!is_relay_log)
+      write_gtid_index();
+
     /* don't pwrite in a file opened with O_APPEND - it doesn't work */
     if (log_file.type == WRITE_CACHE && !(exiting & LOG_CLOSE_DELAYED_CLOSE))
     {
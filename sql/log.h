@@ -20,6 +20,7 @@
 #include "handler.h"                            /* my_xid */
 #include "wsrep_mysqld.h"
 #include "rpl_constants.h"
+#include "sql_string.h"                         /* String */
 
 class Relay_log_info;
 
@@ -89,11 +90,12 @@ class TC_LOG
 */
 extern mysql_mutex_t LOCK_prepare_ordered;
 extern mysql_cond_t COND_prepare_ordered;
+extern mysql_mutex_t LOCK_binlog_sync;
 extern mysql_mutex_t LOCK_after_binlog_sync;
 extern mysql_mutex_t LOCK_commit_ordered;
 #ifdef HAVE_PSI_INTERFACE
 extern PSI_mutex_key key_LOCK_prepare_ordered, key_LOCK_commit_ordered;
-extern PSI_mutex_key key_LOCK_after_binlog_sync;
+extern PSI_mutex_key key_LOCK_binlog_sync, key_LOCK_after_binlog_sync;
 extern PSI_cond_key key_COND_prepare_ordered;
 #endif
 
@@ -540,6 +542,13 @@ class MYSQL_BIN_LOG: public TC_LOG, private MYSQL_LOG
   uint sync_counter;
   bool state_file_deleted;
   bool binlog_state_recover_done;
+  /*
+    Entries of the GTID index of the binlog file being written, see
+    gtid_index_add(). Protected by LOCK_log.
+  */
+  String gtid_index;
+  uint32 gtid_index_count;
+  my_off_t gtid_index_last_offset;
 
   inline uint get_sync_period()
   {
@@ -547,6 +556,10 @@ class MYSQL_BIN_LOG: public TC_LOG, private MYSQL_LOG
   }
 
   int write_to_file(IO_CACHE *cache);
+  int sync_binlog_file(File fd);
+  void wait_for_binlog_sync();
+  void gtid_index_add(my_off_t offset);
+  int write_gtid_index();
   /*
     This is used to start writing to a new log file. The difference from
     new_file() is locking. new_file_without_locking() does not acquire
@@ -766,6 +779,22 @@ class MYSQL_BIN_LOG: public TC_LOG, private MYSQL_LOG
     unlock_binlog_end_pos();
   }
 
+  /**
+    Update binlog_end_pos at the end of the sync stage of a group commit,
+    while holding LOCK_binlog_sync but not LOCK_log. Other writers wait
+    for the sync stage before they move binlog_end_pos.
+  */
+  void update_binlog_end_pos_after_sync(my_off_t pos)
+  {
+    mysql_mutex_assert_owner(&LOCK_binlog_sync);
+    mysql_mutex_assert_not_owner(&LOCK_binlog_end_pos);
+    lock_binlog_end_pos();
+    DBUG_ASSERT(pos >= binlog_end_pos);
+    binlog_end_pos= pos;
+    signal_bin_log_update();
+    unlock_binlog_end_pos();
+  }
+
   void wait_for_sufficient_commits();
   void binlog_trigger_immediate_group_commit();
   void wait_for_update_relay_log(THD* thd);
@@ -831,6 +860,15 @@ class MYSQL_BIN_LOG: public TC_LOG, private MYSQL_LOG
      @retval other Failure
   */
   bool flush_and_sync(bool *synced);
+  /**
+     Flush binlog cache to the OS, without syncing the file.
+
+     @param[out] need_sync set if 'sync_binlog' requires a sync of the file
+
+     @retval 0 Success
+     @retval other Failure
+  */
+  bool flush_for_sync(bool *need_sync);
   int purge_logs(const char *to_log, bool included,
                  bool need_mutex, bool need_update_threads,
                  ulonglong *decrease_log_space);
@@ -1126,6 +1164,29 @@ bool flush_error_log();
 File open_binlog(IO_CACHE *log, const char *log_file_name,
                  const char **errmsg);
 
+/*
+  The GTID index of a binlog file, as written by
+  MYSQL_BIN_LOG::write_gtid_index(). Entry i says that the binlog state
+  was get_list(i) at offset get_offset(i) of the binlog file, which is at
+  the end of an event group. The entries are in binlog order.
+*/
+class Binlog_gtid_index
+{
+  void *mem;
+  my_off_t *offsets;
+  rpl_gtid **lists;
+  uint32 *list_lens;
+public:
+  uint32 count;
+
+  Binlog_gtid_index(): mem(NULL), count(0) {}
+  ~Binlog_gtid_index() { my_free(mem); }
+  bool read(const char *log_file_name, my_off_t log_size);
+  my_off_t get_offset(uint32 i) const { return offsets[i]; }
+  const rpl_gtid *get_list(uint32 i) const { return lists[i]; }
+  uint32 get_list_len(uint32 i) const { return list_lens[i]; }
+};
+
 void make_default_log_name(char **out, const char* log_ext, bool once);
 void binlog_reset_cache(THD *thd);
 
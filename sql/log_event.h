@@ -50,6 +50,7 @@
 #endif
 
 #ifdef MYSQL_SERVER
+#include "rpl_utility.h"
 #include "rpl_record.h"
 #include "rpl_reporting.h"
 #include "sql_class.h"                          /* THD */
@@ -4577,18 +4578,25 @@ class Table_map_log_event : public Log_event
 
   ~Table_map_log_event();
 
-#ifdef MYSQL_CLIENT
   table_def *create_table_def()
   {
     return new table_def(m_coltype, m_colcnt, m_field_metadata,
                          m_field_metadata_size, m_null_bits, m_flags);
   }
+#ifdef MYSQL_CLIENT
   int rewrite_db(const char* new_name, size_t new_name_len,
                  const Format_description_log_event*);
 #endif
   ulonglong get_table_id() const        { return m_table_id; }
   const char *get_table_name() const { return m_tblnam; }
   const char *get_db_name() const    { return m_dbnam; }
+  size_t get_table_name_len() const  { return m_tbllen; }
+  size_t get_db_name_len() const     { return m_dblen; }
+  Optional_metadata_fields get_optional_metadata_fields() const
+  {
+    return Optional_metadata_fields(m_optional_metadata,
+                                    m_optional_metadata_len);
+  }
 
   virtual Log_event_type get_type_code() { return TABLE_MAP_EVENT; }
   virtual enum_logged_status logged_status() { return LOGGED_TABLE_MAP; }
@@ -4772,6 +4780,7 @@ class Rows_log_event : public Log_event
 
 #if defined(MYSQL_SERVER) && defined(HAVE_REPLICATION)
   virtual void pack_info(Protocol *protocol);
+  bool prefetch_rows(rpl_group_info *rgi);
 #endif
 
 #ifdef MYSQL_CLIENT
@@ -4807,6 +4816,8 @@ class Rows_log_event : public Log_event
   MY_BITMAP const *get_cols_ai() const { return &m_cols_ai; }
   size_t get_width() const          { return m_width; }
   ulonglong get_table_id() const        { return m_table_id; }
+  const uchar *get_rows_buf() const { return m_rows_buf; }
+  const uchar *get_rows_end() const { return m_rows_cur; }
 
 #if defined(MYSQL_SERVER)
   /*
@@ -5081,6 +5081,113 @@ static void restore_empty_query_table_list(LEX *lex)
 }
 
 
+/**
+  Unpack the columns of a row image that are part of a key into
+  table->record[0], and skip the other columns. With keynr == MAX_KEY,
+  only skip the row image.
+
+  @return the end of the row image, or NULL if it can not be parsed
+*/
+static const uchar *
+unpack_key_columns(TABLE *table, table_def *tabledef, uint keynr,
+                   MY_BITMAP const *cols, const uchar *row,
+                   const uchar *row_end)
+{
+  const uchar *null_ptr= row;
+  const uchar *ptr= row + (bitmap_bits_set(cols) + 7) / 8;
+  uint null_idx= 0;
+
+  if (ptr > row_end)
+    return NULL;
+  for (uint i= 0; i < cols->n_bits; i++)
+  {
+    if (!bitmap_is_set(cols, i))
+      continue;
+    bool is_null= null_ptr[null_idx / 8] & (1U << (null_idx % 8));
+    null_idx++;
+    if (is_null)
+      continue;
+
+    Field *field= i < table->s->fields ? table->field[i] : NULL;
+    if (field && keynr < MAX_KEY && field->part_of_key.is_set(keynr))
+    {
+      field->set_notnull();
+      if (!(ptr= field->unpack(field->ptr, ptr, row_end,
+                               tabledef->field_metadata(i))))
+        return NULL;
+    }
+    else
+    {
+      uint32 len= tabledef->calc_field_size(i, (uchar *) ptr);
+      if (len > (size_t) (row_end - ptr))
+        return NULL;
+      ptr+= len;
+    }
+  }
+  return ptr;
+}
+
+
+/**
+  Ask the storage engine to read ahead the primary key pages that
+  applying the rows of this event will look up.
+
+  The rows are unpacked into table->record[0], so this must not be called
+  while another row event of the table is being applied.
+
+  @retval false  The table of this event is not opened yet.
+  @retval true   Done, or nothing to read ahead.
+*/
+bool Rows_log_event::prefetch_rows(rpl_group_info *rgi)
+{
+  TABLE *table= rgi->m_table_map.get_table(m_table_id);
+  table_def *tabledef;
+  TABLE *conv_table;
+  DBUG_ENTER("Rows_log_event::prefetch_rows");
+
+  if (!table)
+    DBUG_RETURN(false);
+
+  uint keynr= table->s->primary_key;
+  /* Type conversions are left to the row application. */
+  if (keynr >= MAX_KEY || !m_rows_buf ||
+      !rgi->get_table_data(table, &tabledef, &conv_table) || conv_table ||
+      m_width > table->s->fields)
+    DBUG_RETURN(true);
+
+  KEY *key_info= table->key_info + keynr;
+  for (uint i= 0; i < key_info->user_defined_key_parts; i++)
+  {
+    uint col= key_info->key_part[i].fieldnr - 1;
+    if (col >= m_width || !bitmap_is_set(&m_cols, col))
+      DBUG_RETURN(true);
+  }
+
+  bool update= get_general_type_code() == UPDATE_ROWS_EVENT;
+  uchar key[MAX_KEY_LENGTH];
+  my_bitmap_map *old_read_map= dbug_tmp_use_all_columns(table,
+                                                        table->read_set);
+  my_bitmap_map *old_write_map= dbug_tmp_use_all_columns(table,
+                                                         table->write_set);
+  for (const uchar *row= m_rows_buf; row < m_rows_end; )
+  {
+    if (!(row= unpack_key_columns(table, tabledef, keynr, &m_cols, row,
+                                  m_rows_end)))
+      break;
+    key_copy(key, table->record[0], key_info, key_info->key_length);
+    table->file->prefetch_index_read(keynr, key, key_info->key_length);
+    /* Skip the after image of an update. */
+    if (update &&
+        !(row= unpack_key_columns(table, tabledef, MAX_KEY, &m_cols_ai,
+                                  row, m_rows_end)))
+      break;
+  }
+  dbug_tmp_restore_column_map(table->write_set, old_write_map);
+  dbug_tmp_restore_column_map(table->read_set, old_read_map);
+  DBUG_RETURN(true);
+}
+
+
 int Rows_log_event::do_apply_event(rpl_group_info *rgi)
 {
   Relay_log_info const *rli= rgi->rli;
@@ -0,0 +1,363 @@
+/*
+   Copyright (c) 2020, MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1335  USA */
+
+/*
+  Cache of join orders of prepared statements, see opt_plan_cache.h.
+
+  The key of an entry is the key of the prepared statement, built by
+  Prepared_statement::execute() from the statement digest, the current
+  database and the parameter types, followed by the number of the SELECT
+  and the optimizer settings that affect the join order search.
+*/
+
+#include "mariadb.h"
+#include "sql_priv.h"
+#include "sql_select.h"
+#include "sql_plist.h"
+#include "opt_plan_cache.h"
+
+/* Maximum number of cached join orders, 0 disables the cache */
+ulong plan_cache_size;
+ulong plan_cache_hit, plan_cache_miss, plan_cache_invalidations;
+
+/**
+  A table in a cached join order, with what is needed to check that
+  the order is still good for it.
+*/
+
+struct Plan_cache_table
+{
+  uint tablenr;
+  /* Estimate of rows in the table when the order was chosen */
+  ha_rows records;
+  uint version_length;
+  uchar version[MY_UUID_SIZE];
+};
+
+
+struct Plan_cache_entry
+{
+  uchar *key;
+  size_t key_length;
+  table_map const_tables;
+  uint table_count;
+  /* Join order of the non-constant tables */
+  Plan_cache_table *order;
+  uint order_count;
+  Plan_cache_entry *next_in_lru;
+  Plan_cache_entry **prev_in_lru;
+};
+
+
+typedef I_P_List<Plan_cache_entry,
+                 I_P_List_adapter<Plan_cache_entry,
+                                  &Plan_cache_entry::next_in_lru,
+                                  &Plan_cache_entry::prev_in_lru>,
+                 I_P_List_null_counter,
+                 I_P_List_fast_push_back<Plan_cache_entry> >
+        Plan_cache_lru;
+
+
+/*
+  Rows estimate may change this many times, plus PLAN_CACHE_MIN_ROWS,
+  before a cached join order is considered stale.
+*/
+#define PLAN_CACHE_MAX_ROWS_CHANGE 2
+#define PLAN_CACHE_MIN_ROWS 100
+
+static mysql_mutex_t LOCK_plan_cache;
+/* Protected by LOCK_plan_cache */
+static HASH plan_cache;
+/* Least recently used entry first, protected by LOCK_plan_cache */
+static Plan_cache_lru plan_cache_lru;
+
+#ifdef HAVE_PSI_INTERFACE
+static PSI_mutex_key key_LOCK_plan_cache;
+static PSI_mutex_info all_plan_cache_mutexes[]=
+{
+  { &key_LOCK_plan_cache, "LOCK_plan_cache", PSI_FLAG_GLOBAL }
+};
+#endif
+
+
+static uchar *plan_cache_get_key(const Plan_cache_entry *entry,
+                                 size_t *length, my_bool)
+{
+  *length= entry->key_length;
+  return entry->key;
+}
+
+
+void plan_cache_init()
+{
+#ifdef HAVE_PSI_INTERFACE
+  mysql_mutex_register("sql", all_plan_cache_mutexes,
+                       array_elements(all_plan_cache_mutexes));
+#endif
+  mysql_mutex_init(key_LOCK_plan_cache, &LOCK_plan_cache, MY_MUTEX_INIT_FAST);
+  my_hash_init(&plan_cache, &my_charset_bin, 64, 0, 0,
+               (my_hash_get_key) plan_cache_get_key, my_free, 0);
+  plan_cache_lru.empty();
+}
+
+
+void plan_cache_free()
+{
+  plan_cache_lru.empty();
+  my_hash_free(&plan_cache);
+  mysql_mutex_destroy(&LOCK_plan_cache);
+}
+
+
+/** Evict least recently used entries, until there are at most size left */
+
+static void plan_cache_evict(ulong size)
+{
+  mysql_mutex_assert_owner(&LOCK_plan_cache);
+  while (plan_cache.records > size)
+  {
+    Plan_cache_entry *entry= plan_cache_lru.pop_front();
+    my_hash_delete(&plan_cache, (uchar*) entry);
+  }
+}
+
+
+void plan_cache_resize(ulong size)
+{
+  mysql_mutex_lock(&LOCK_plan_cache);
+  plan_cache_evict(size);
+  mysql_mutex_unlock(&LOCK_plan_cache);
+}
+
+
+/**
+  Drop all cached join orders, because table statistics have changed.
+*/
+
+void plan_cache_invalidate()
+{
+  mysql_mutex_lock(&LOCK_plan_cache);
+  ulong dropped= plan_cache.records;
+  plan_cache_lru.empty();
+  my_hash_reset(&plan_cache);
+  mysql_mutex_unlock(&LOCK_plan_cache);
+  statistic_add(plan_cache_invalidations, dropped, &LOCK_status);
+}
+
+
+/**
+  Check whether the join order of the join may be cached.
+
+  Only SELECTs of prepared statements are cached. Joins with semi-join
+  nests are not, as their plan is more than a join order.
+*/
+
+static bool plan_cache_usable(JOIN *join)
+{
+  return plan_cache_size &&
+         join->thd->lex->plan_cache_key.length &&
+         !join->emb_sjm_nest &&
+         join->select_lex->sj_nests.is_empty() &&
+         join->table_count - join->const_tables > 1;
+}
+
+
+/**
+  @retval false  OK
+  @retval true   Out of memory
+*/
+
+static bool plan_cache_make_key(JOIN *join, String *key)
+{
+  THD *thd= join->thd;
+  char tail[4 + 8 + 4 + 4 + 4];
+
+  int4store(tail, join->select_lex->select_number);
+  int8store(tail + 4, thd->variables.optimizer_switch);
+  int4store(tail + 12, thd->variables.optimizer_search_depth);
+  int4store(tail + 16, thd->variables.optimizer_prune_level);
+  int4store(tail + 20, thd->variables.optimizer_use_condition_selectivity);
+  return key->append(thd->lex->plan_cache_key.str,
+                     thd->lex->plan_cache_key.length) ||
+         key->append(tail, sizeof(tail));
+}
+
+
+/**
+  Check that the table has not been altered, and that its rows
+  estimate has not changed much, since the join order was cached.
+*/
+
+static bool plan_cache_same_table(TABLE *table, const Plan_cache_table *t)
+{
+  const LEX_CUSTRING &version= table->s->tabledef_version;
+  ha_rows records= table->stat_records();
+
+  return version.length == t->version_length &&
+         !memcmp(version.str, t->version, version.length) &&
+         records <= PLAN_CACHE_MAX_ROWS_CHANGE * t->records +
+                    PLAN_CACHE_MIN_ROWS &&
+         t->records <= PLAN_CACHE_MAX_ROWS_CHANGE * records +
+                       PLAN_CACHE_MIN_ROWS;
+}
+
+
+/**
+  Look up a cached join order for the join.
+
+  If found, the non-constant tables in join->best_ref are put in that
+  order, and the caller only needs to compute their access methods.
+
+  @retval true   Cached order found and applied
+  @retval false  No usable cached order
+*/
+
+bool plan_cache_apply(JOIN *join)
+{
+  StringBuffer<256> key(&my_charset_bin);
+  JOIN_TAB *order[MAX_TABLES];
+  JOIN_TAB **tabs= join->best_ref + join->const_tables;
+  uint count= join->table_count - join->const_tables;
+  bool found= false, stale= false;
+
+  if (!plan_cache_usable(join) || plan_cache_make_key(join, &key))
+    return false;
+
+  mysql_mutex_lock(&LOCK_plan_cache);
+  Plan_cache_entry *entry= (Plan_cache_entry*)
+    my_hash_search(&plan_cache, (uchar*) key.ptr(), key.length());
+  if (entry && entry->table_count == join->table_count &&
+      entry->const_tables == join->const_table_map &&
+      entry->order_count == count)
+  {
+    found= true;
+    for (uint i= 0; found && i < count; i++)
+    {
+      const Plan_cache_table *t= &entry->order[i];
+      order[i]= NULL;
+      for (uint j= 0; j < count; j++)
+      {
+        if (tabs[j]->table->tablenr == t->tablenr)
+        {
+          order[i]= tabs[j];
+          break;
+        }
+      }
+      found= order[i] && plan_cache_same_table(order[i]->table, t);
+      stale= order[i] && !found;
+    }
+    if (found)
+    {
+      /*
+        Every table must still come after the tables it depends on.
+        This may no longer hold, e.g. when a view was redefined with
+        an outer join.
+      */
+      table_map prefix= join->const_table_map;
+      for (uint i= 0; found && i < count; i++)
+      {
+        found= !(order[i]->dependent & ~prefix);
+        prefix|= order[i]->table->map;
+      }
+      stale= !found;
+    }
+    if (found)
+    {
+      plan_cache_lru.remove(entry);
+      plan_cache_lru.push_back(entry);
+    }
+  }
+  mysql_mutex_unlock(&LOCK_plan_cache);
+
+  if (found)
+  {
+    statistic_increment(plan_cache_hit, &LOCK_status);
+    memcpy(tabs, order, count * sizeof(JOIN_TAB*));
+  }
+  else
+  {
+    statistic_increment(plan_cache_miss, &LOCK_status);
+    /* The entry is replaced by plan_cache_store() */
+    if (stale)
+      statistic_increment(plan_cache_invalidations, &LOCK_status);
+  }
+  return found;
+}
+
+
+/**
+  Remember the join order chosen for the join in join->best_positions.
+  An existing entry for the same key is replaced.
+*/
+
+void plan_cache_store(JOIN *join)
+{
+  StringBuffer<256> key(&my_charset_bin);
+  uint count= join->table_count - join->const_tables;
+  Plan_cache_entry *entry;
+  Plan_cache_table *order;
+  uchar *key_buff;
+
+  if (!plan_cache_usable(join) || plan_cache_make_key(join, &key))
+    return;
+
+  if (!my_multi_malloc(MYF(0),
+                       &entry, sizeof(*entry),
+                       &key_buff, (uint) key.length(),
+                       &order, (uint) (count * sizeof(*order)),
+                       NullS))
+    return;
+
+  memcpy(key_buff, key.ptr(), key.length());
+  entry->key= key_buff;
+  entry->key_length= key.length();
+  entry->const_tables= join->const_table_map;
+  entry->table_count= join->table_count;
+  entry->order= order;
+  entry->order_count= count;
+
+  for (uint i= 0; i < count; i++)
+  {
+    TABLE *table= join->best_positions[join->const_tables + i].table->table;
+    const LEX_CUSTRING &version= table->s->tabledef_version;
+    if (version.length > sizeof(order[i].version))
+    {
+      my_free(entry);
+      return;
+    }
+    order[i].tablenr= table->tablenr;
+    order[i].records= table->stat_records();
+    order[i].version_length= (uint) version.length;
+    if (version.length)
+      memcpy(order[i].version, version.str, version.length);
+  }
+
+  mysql_mutex_lock(&LOCK_plan_cache);
+  if (Plan_cache_entry *old= (Plan_cache_entry*)
+        my_hash_search(&plan_cache, key_buff, entry->key_length))
+  {
+    plan_cache_lru.remove(old);
+    my_hash_delete(&plan_cache, (uchar*) old);
+  }
+  if (my_hash_insert(&plan_cache, (uchar*) entry))
+    my_free(entry);
+  else
+  {
+    plan_cache_lru.push_back(entry);
+    plan_cache_evict(plan_cache_size);
+  }
+  mysql_mutex_unlock(&LOCK_plan_cache);
+}
@@ -0,0 +1,47 @@
+#ifndef OPT_PLAN_CACHE_INCLUDED
+#define OPT_PLAN_CACHE_INCLUDED
+/*
+   Copyright (c) 2020, MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1335  USA */
+
+/*
+  Cache of join orders of prepared statements, shared by all connections.
+
+  The join order search (greedy_search()) is the most expensive part of
+  the optimization of a multi-table join, and it is repeated on every
+  execution of a prepared statement, in every connection that prepared
+  it. The cache remembers the join order chosen for a SELECT of a
+  prepared statement, so that later executions with the same statement
+  digest and parameter types only need to compute the access methods
+  for that order, see optimize_straight_join().
+
+  An entry is ignored, and replaced, when a table of the join was
+  altered (its tabledef_version differs) or its row count estimate has
+  changed considerably. ANALYZE TABLE empties the whole cache.
+*/
+
+class JOIN;
+
+extern ulong plan_cache_size;
+extern ulong plan_cache_hit, plan_cache_miss, plan_cache_invalidations;
+
+void plan_cache_init();
+void plan_cache_free();
+void plan_cache_resize(ulong size);
+void plan_cache_invalidate();
+bool plan_cache_apply(JOIN *join);
+void plan_cache_store(JOIN *join);
+
+#endif /* OPT_PLAN_CACHE_INCLUDED */
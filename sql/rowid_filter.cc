@@ -20,6 +20,7 @@
 #include "opt_range.h"
 #include "rowid_filter.h"
 #include "sql_select.h"
+#include "key.h"
 
 
 inline
@@ -29,6 +30,8 @@ double Range_rowid_filter_cost_info::lookup_cost(
   switch (cont_type) {
   case SORTED_ARRAY_CONTAINER:
     return log(est_elements)*0.01;
+  case BLOOM_FILTER_CONTAINER:
+    return BLOOM_FILTER_LOOKUP_COST;
   default:
     DBUG_ASSERT(0);
     return 0;
@@ -115,6 +118,13 @@ void Range_rowid_filter_cost_info::init(Rowid_filter_container_type cont_type,
   est_elements= (ulonglong) (table->quick_rows[key_no]);
   b= build_cost(container_type);
   selectivity= est_elements/((double) table->stat_records());
+  /*
+    A bloom filter lets through a part of the rows that are not in the set.
+    These false positives are accounted for as a worse selectivity.
+  */
+  if (container_type == BLOOM_FILTER_CONTAINER)
+    selectivity+= (1 - selectivity) *
+                  Rowid_filter_bloom_filter::false_positive_rate();
   a= avg_access_and_eval_gain_per_row(container_type);
   if (a > 0)
     cross_x= b/a;
@@ -142,6 +152,9 @@ Range_rowid_filter_cost_info::build_cost(Rowid_filter_container_type cont_type)
     cost+= ARRAY_WRITE_COST * est_elements; /* cost filling the container */
     cost+= ARRAY_SORT_C * est_elements * log(est_elements); /* sorting cost */
     break;
+  case BLOOM_FILTER_CONTAINER:
+    cost+= BLOOM_FILTER_WRITE_COST * est_elements; /* no sorting is needed */
+    break;
   default:
     DBUG_ASSERT(0);
   }
@@ -161,6 +174,10 @@ Rowid_filter_container *Range_rowid_filter_cost_info::create_container()
     res= new (thd->mem_root) Rowid_filter_sorted_array((uint) est_elements,
                                                        elem_sz);
     break;
+  case BLOOM_FILTER_CONTAINER:
+    res= new (thd->mem_root) Rowid_filter_bloom_filter(table,
+                                                       (uint) est_elements);
+    break;
   default:
     DBUG_ASSERT(0);
   }
@@ -311,6 +328,8 @@ get_max_range_rowid_filter_elems_for_table(
   switch (cont_type) {
   case SORTED_ARRAY_CONTAINER :
     return thd->variables.max_rowid_filter_size/tab->file->ref_length;
+  case BLOOM_FILTER_CONTAINER :
+    return thd->variables.max_rowid_filter_size*8/BLOOM_FILTER_BITS_PER_ELEM;
   default :
     DBUG_ASSERT(0);
     return 0;
@@ -318,6 +337,35 @@ get_max_range_rowid_filter_elems_for_table(
 }
 
 
+/**
+  @brief
+    Choose the type of the container for a range filter
+
+  @param thd     The thread handler
+  @param tab     The table for which the range filter is evaluated
+  @param key_no  The index used to create the range filter
+
+  @details
+    A sorted array is used when it fits into max_rowid_filter_size, as it
+    does not let through any rows that are not in the set. Otherwise a bloom
+    filter is used: it needs only BLOOM_FILTER_BITS_PER_ELEM bits per element
+    and its lookup cost does not depend on the number of elements.
+
+  @retval
+    The chosen container type
+*/
+
+static Rowid_filter_container_type
+choose_range_rowid_filter_container(THD *thd, TABLE *tab, uint key_no)
+{
+  if (tab->quick_rows[key_no] >
+      get_max_range_rowid_filter_elems_for_table(thd, tab,
+                                                 SORTED_ARRAY_CONTAINER))
+    return BLOOM_FILTER_CONTAINER;
+  return SORTED_ARRAY_CONTAINER;
+}
+
+
 /**
   @brief
     Prepare info on possible range filters used by optimizer
@@ -360,7 +408,7 @@ void TABLE::init_cost_info_for_usable_range_rowid_filters(THD *thd)
       continue;
    if (quick_rows[key_no] >
        get_max_range_rowid_filter_elems_for_table(thd, this,
-                                                  SORTED_ARRAY_CONTAINER)) // !3
+                                                  BLOOM_FILTER_CONTAINER)) // !3
       continue;
     usable_range_filter_keys.set_bit(key_no);
   }
@@ -397,7 +445,9 @@ void TABLE::init_cost_info_for_usable_range_rowid_filters(THD *thd)
   while ((key_no= li++) != key_map::Iterator::BITMAP_END)
   {
     *curr_ptr= curr_filter_cost_info;
-    curr_filter_cost_info->init(SORTED_ARRAY_CONTAINER, this, key_no);
+    curr_filter_cost_info->init(choose_range_rowid_filter_container(thd, this,
+                                                                    key_no),
+                                this, key_no);
     curr_ptr++;
     curr_filter_cost_info++;
   }
@@ -609,6 +659,120 @@ bool Rowid_filter_sorted_array::check(void *ctxt, char *elem)
 }
 
 
+/**
+  @brief
+    The probability of a false positive answer of a bloom filter check
+
+  @details
+    The probability is calculated by the usual formula (1-e^(-k/b))^k
+    where k is the number of bits set per element and b is the number
+    of bits in the filter per element. It assumes that the number of
+    elements in the filter does not exceed the expected one.
+*/
+
+double Rowid_filter_bloom_filter::false_positive_rate()
+{
+  return pow(1 - exp(-(double) BLOOM_FILTER_HASH_FUNCS /
+                     BLOOM_FILTER_BITS_PER_ELEM),
+             BLOOM_FILTER_HASH_FUNCS);
+}
+
+
+bool Rowid_filter_bloom_filter::alloc()
+{
+  /* Round the size of the bit array up to a whole number of words */
+  ulonglong n_words= ((ulonglong) max_elements * BLOOM_FILTER_BITS_PER_ELEM +
+                      63) / 64;
+  set_if_bigger(n_words, 1);
+  n_bits= n_words * 64;
+  bits= (ulonglong *) my_malloc((size_t) (n_words * sizeof(ulonglong)),
+                                MYF(MY_ZEROFILL | MY_THREAD_SPECIFIC));
+  return bits == NULL;
+}
+
+
+Rowid_filter_bloom_filter::~Rowid_filter_bloom_filter()
+{
+  my_free(bits);
+  bits= 0;
+}
+
+
+/**
+  @brief
+    Calculate the hash value of a rowid / primary key
+
+  @details
+    See the comment for the class Rowid_filter_bloom_filter.
+    The result of the hash function is additionally mixed, as the bloom
+    filter uses both halves of it to get the positions of its bits.
+*/
+
+ulonglong Rowid_filter_bloom_filter::hash(const char *elem)
+{
+  ulonglong nr;
+  uint pk= table->s->primary_key;
+  if (pk != MAX_KEY && table->file->primary_key_is_clustered())
+  {
+    KEY *key_info= table->key_info + pk;
+    nr= key_hashnr(key_info, key_info->user_defined_key_parts,
+                   (const uchar *) elem);
+  }
+  else
+  {
+    ulong nr1= 1, nr2= 4;
+    my_charset_bin.coll->hash_sort(&my_charset_bin, (const uchar *) elem,
+                                   table->file->ref_length, &nr1, &nr2);
+    nr= nr1;
+  }
+  /* The finalizer of MurmurHash3 */
+  nr^= nr >> 33;
+  nr*= 0xff51afd7ed558ccdULL;
+  nr^= nr >> 33;
+  nr*= 0xc4ceb3fe1a85ec53ULL;
+  nr^= nr >> 33;
+  return nr;
+}
+
+
+bool Rowid_filter_bloom_filter::add(void *ctxt, char *elem)
+{
+  ulonglong nr= hash(elem);
+  ulonglong h1= nr & 0xffffffffULL;
+  ulonglong h2= (nr >> 32) | 1;
+  for (uint i= 0; i < BLOOM_FILTER_HASH_FUNCS; i++)
+  {
+    ulonglong pos= (h1 + i * h2) % n_bits;
+    bits[pos / 64]|= 1ULL << (pos % 64);
+  }
+  return false;
+}
+
+
+/**
+  @brief
+    Check whether a rowid / primary key may be in the bloom filter
+
+  @retval
+    true    elem may be in the container
+    false   elem is definitely not in the container
+*/
+
+bool Rowid_filter_bloom_filter::check(void *ctxt, char *elem)
+{
+  ulonglong nr= hash(elem);
+  ulonglong h1= nr & 0xffffffffULL;
+  ulonglong h2= (nr >> 32) | 1;
+  for (uint i= 0; i < BLOOM_FILTER_HASH_FUNCS; i++)
+  {
+    ulonglong pos= (h1 + i * h2) % n_bits;
+    if (!(bits[pos / 64] & (1ULL << (pos % 64))))
+      return false;
+  }
+  return true;
+}
+
+
 Range_rowid_filter::~Range_rowid_filter()
 {
   delete container;
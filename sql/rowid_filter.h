@@ -149,11 +149,19 @@ class Range_rowid_filter_cost_info;
 #define ARRAY_SORT_C          0.01
 /* Cost to evaluate condition */
 #define COST_COND_EVAL  0.2
+/* Cost to hash a rowid and set the bits for it in a bloom filter */
+#define BLOOM_FILTER_WRITE_COST   0.01
+/* Cost to hash a rowid and probe the bits for it in a bloom filter */
+#define BLOOM_FILTER_LOOKUP_COST  0.03
+/* Number of bits allocated in a bloom filter per expected element */
+#define BLOOM_FILTER_BITS_PER_ELEM  10
+/* Number of bits set / probed in a bloom filter per element */
+#define BLOOM_FILTER_HASH_FUNCS     7
 
 typedef enum
 {
   SORTED_ARRAY_CONTAINER,
-  BLOOM_FILTER_CONTAINER      // Not used yet
+  BLOOM_FILTER_CONTAINER
 } Rowid_filter_container_type;
 
 /**
@@ -162,7 +170,7 @@ typedef enum
   The interface for different types of containers to store info on the set
   of rowids / primary keys that defines a pk-filter.
 
-  There will be two implementations of this abstract class.
+  There are two implementations of this abstract class.
   - sorted array
   - bloom filter
 */
@@ -370,6 +378,58 @@ class Rowid_filter_sorted_array: public Rowid_filter_container
   bool check(void *ctxt, char *elem);
 };
 
+
+/**
+  @class Rowid_filter_bloom_filter
+
+  The implementation of the Rowid_filter_container interface as
+  a bloom filter built over rowids / primary keys.
+
+  The filter uses a bit array with BLOOM_FILTER_BITS_PER_ELEM bits per
+  expected element. For each element BLOOM_FILTER_HASH_FUNCS bits are set
+  whose positions are obtained by double hashing from one hash value.
+  The check never gives false negatives, yet it may give false positives
+  with the probability returned by false_positive_rate().
+
+  Rowids of equal rows must produce equal hash values. When the rowid
+  is the value of a clustered primary key, two rowids may be equal
+  according to handler::cmp_ref() while their images differ (e.g. for
+  case insensitive collations). That's why for such tables the hash value
+  is calculated by key_hashnr() over the components of the primary key.
+  Otherwise the rowid is hashed as a binary string.
+*/
+
+class Rowid_filter_bloom_filter: public Rowid_filter_container
+{
+  /* The table whose rowids are stored in the filter */
+  TABLE *table;
+  /* Expected number of elements in the filter */
+  uint max_elements;
+  /* Number of bits in the bit array */
+  ulonglong n_bits;
+  /* The bit array */
+  ulonglong *bits;
+
+  ulonglong hash(const char *elem);
+
+public:
+  Rowid_filter_bloom_filter(TABLE *tab, uint elems)
+    : table(tab), max_elements(elems), n_bits(0), bits(0) {}
+
+  ~Rowid_filter_bloom_filter();
+
+  Rowid_filter_container_type get_type()
+  { return BLOOM_FILTER_CONTAINER; }
+
+  bool alloc();
+
+  bool add(void *ctxt, char *elem);
+
+  bool check(void *ctxt, char *elem);
+
+  static double false_positive_rate();
+};
+
 /**
   @class Range_rowid_filter_cost_info
 
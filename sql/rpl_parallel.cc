@@ -448,6 +448,62 @@ do_ftwrl_wait(rpl_group_info *rgi,
 }
 
 
+/*
+  In slave_parallel_mode=writeset, wait until the SQL driver thread has
+  collected the writeset of the event group, and until the prior event
+  groups that changed the same rows have committed.
+*/
+static void
+do_writeset_wait(rpl_group_info *rgi,
+                 bool *did_enter_cond, PSI_stage_info *old_stage)
+{
+  THD *thd= rgi->thd;
+  rpl_parallel_entry *entry= rgi->parallel_entry;
+  DBUG_ENTER("do_writeset_wait");
+
+  mysql_mutex_assert_owner(&entry->LOCK_parallel_entry);
+
+  if (rgi->writeset_done &&
+      rgi->writeset_dep_sub_id <= entry->last_committed_sub_id)
+    DBUG_VOID_RETURN;
+
+  if (!*did_enter_cond)
+  {
+    thd->ENTER_COND(&entry->COND_parallel_entry, &entry->LOCK_parallel_entry,
+                    &stage_waiting_for_prior_transaction_to_commit,
+                    old_stage);
+    *did_enter_cond= true;
+  }
+  thd->set_time_for_next_stage();
+  ++entry->need_sub_id_signal;
+  do
+  {
+    if (entry->force_abort || rgi->worker_error)
+    {
+      /* Fall back to waiting for the prior commit as in conservative mode. */
+      rgi->speculation= rpl_group_info::SPECULATE_WAIT;
+      break;
+    }
+    if (unlikely(thd->check_killed()))
+    {
+      slave_output_error_info(rgi, thd);
+      signal_error_to_sql_driver_thread(thd, rgi, 1);
+      break;
+    }
+    DBUG_EXECUTE_IF("rpl_parallel_writeset_wait", {
+        if (rgi->writeset_done)
+          debug_sync_set_action(thd,
+                                STRING_WITH_LEN("now SIGNAL writeset_waiting"));
+      });
+    mysql_cond_wait(&entry->COND_parallel_entry, &entry->LOCK_parallel_entry);
+  } while (!rgi->writeset_done ||
+           rgi->writeset_dep_sub_id > entry->last_committed_sub_id);
+  --entry->need_sub_id_signal;
+
+  DBUG_VOID_RETURN;
+}
+
+
 static int
 pool_mark_busy(rpl_parallel_thread_pool *pool, THD *thd)
 {
@@ -1027,6 +1083,42 @@ retry_event_group(rpl_group_info *rgi, rpl_parallel_thread *rpt,
 }
 
 
+/*
+  Ask the storage engine to read ahead the rows of the next
+  opt_slave_parallel_prefetch row events of the event group, starting with
+  the one about to be applied, so that their page reads overlap instead of
+  being waited for one row at a time.
+
+  Only events already dequeued by this worker are looked at, and only those
+  on tables that the event group has opened; the others are tried again
+  before the next event is applied.
+*/
+static void
+prefetch_queued_rows(rpl_group_info *rgi,
+                     rpl_parallel_thread::queued_event *qev)
+{
+  ulong count= opt_slave_parallel_prefetch;
+
+  for (; qev && count && qev->rgi == rgi; qev= qev->next)
+  {
+    if (qev->typ != rpl_parallel_thread::queued_event::QUEUED_EVENT)
+      break;
+    Log_event_type typ= qev->ev->get_type_code();
+    if (!LOG_EVENT_IS_WRITE_ROW(typ) && !LOG_EVENT_IS_UPDATE_ROW(typ) &&
+        !LOG_EVENT_IS_DELETE_ROW(typ))
+    {
+      if (is_group_ending(qev->ev, typ))
+        break;
+      continue;
+    }
+    --count;
+    if (!qev->prefetched)
+      qev->prefetched=
+        static_cast<Rows_log_event *>(qev->ev)->prefetch_rows(rgi);
+  }
+}
+
+
 pthread_handler_t
 handle_rpl_parallel_thread(void *arg)
 {
@@ -1222,6 +1314,8 @@ handle_rpl_parallel_thread(void *arg)
         }
         if (likely(!skip_event_group))
           do_ftwrl_wait(rgi, &did_enter_cond, &old_stage);
+        if (likely(!skip_event_group) && rgi->writeset_wait)
+          do_writeset_wait(rgi, &did_enter_cond, &old_stage);
 
         /*
           Register ourself to wait for the previous commit, if we need to do
@@ -1337,7 +1431,14 @@ handle_rpl_parallel_thread(void *arg)
             err= 1;
           }
           else
+          {
+            if (opt_slave_parallel_prefetch &&
+                (LOG_EVENT_IS_WRITE_ROW(event_type) ||
+                 LOG_EVENT_IS_UPDATE_ROW(event_type) ||
+                 LOG_EVENT_IS_DELETE_ROW(event_type)))
+              prefetch_queued_rows(rgi, qev);
             err= rpt_handle_event(qev, rpt);
+          }
         }
         delete_or_keep_event_post_apply(rgi, event_type, qev->ev);
         DBUG_EXECUTE_IF("rpl_parallel_simulate_temp_err_gtid_0_x_100",
@@ -1797,6 +1898,7 @@ rpl_parallel_thread::get_qev_common(Log_event *ev, ulonglong event_size)
   qev->typ= rpl_parallel_thread::queued_event::QUEUED_EVENT;
   qev->ev= ev;
   qev->event_size= (size_t)event_size;
+  qev->prefetched= false;
   qev->next= NULL;
   return qev;
 }
@@ -1915,6 +2017,7 @@ rpl_parallel_thread::get_rgi(Relay_log_info *rli, Gtid_log_event *gtid_ev,
   rgi->retry_start_offset= rli->future_event_relay_log_pos-event_size;
   rgi->retry_event_count= 0;
   rgi->killed_for_retry= rpl_group_info::RETRY_KILL_NONE;
+  rgi->writeset_wait= false;
 
   return rgi;
 }
@@ -2192,22 +2295,29 @@ free_rpl_parallel_entry(void *element)
   }
   mysql_cond_destroy(&e->COND_parallel_entry);
   mysql_mutex_destroy(&e->LOCK_parallel_entry);
+  my_free(e->writeset_history);
   my_free(e);
 }
 
 
 rpl_parallel::rpl_parallel() :
-  current(NULL), sql_thread_stopping(false)
+  current(NULL), sql_thread_stopping(false),
+  writeset_entry(NULL), writeset_rgi(NULL)
 {
   my_hash_init(&domain_hash, &my_charset_bin, 32,
                offsetof(rpl_parallel_entry, domain_id), sizeof(uint32),
                NULL, free_rpl_parallel_entry, HASH_UNIQUE);
+  my_init_dynamic_array(&writeset_tables, sizeof(rpl_writeset_table), 16, 16,
+                        MYF(0));
 }
 
 
 void
 rpl_parallel::reset()
 {
+  writeset_free_tables();
+  writeset_entry= NULL;
+  writeset_rgi= NULL;
   my_hash_reset(&domain_hash);
   current= NULL;
   sql_thread_stopping= false;
@@ -2216,6 +2326,8 @@ rpl_parallel::reset()
 
 rpl_parallel::~rpl_parallel()
 {
+  writeset_free_tables();
+  delete_dynamic(&writeset_tables);
   my_hash_free(&domain_hash);
 }
 
@@ -2274,6 +2386,10 @@ rpl_parallel::wait_for_done(THD *thd, Relay_log_info *rli)
   rpl_parallel_thread *rpt;
   uint32 i, j;
 
+  /* No more events will be queued for a partially queued event group. */
+  if (writeset_entry)
+    writeset_end_group();
+
   /*
     First signal all workers that they must force quit; no more events will
     be queued to complete any partial event groups executed.
@@ -2305,6 +2421,8 @@ rpl_parallel::wait_for_done(THD *thd, Relay_log_info *rli)
     e->force_abort= true;
     e->stop_count= rli->stop_for_until ?
       e->count_queued_event_groups : e->count_committing_event_groups;
+    /* Wake up any worker in do_writeset_wait(). */
+    mysql_cond_broadcast(&e->COND_parallel_entry);
     mysql_mutex_unlock(&e->LOCK_parallel_entry);
     for (j= 0; j < e->rpl_thread_max; ++j)
     {
@@ -2523,6 +2641,293 @@ abandon_worker_thread(THD *thd, rpl_parallel_thread *cur_thread,
 }
 
 
+/*
+  Writeset tracking for slave_parallel_mode=writeset.
+
+  While queueing an event group, the SQL driver thread computes a hash of
+  every row changed by its row events: of the primary key columns when the
+  table map includes the primary key (binlog_row_metadata=FULL on the
+  master), otherwise of the whole row image. The hash indexes
+  rpl_parallel_entry::writeset_history, which remembers the last event
+  group that changed a row with the same hash. The worker does not start
+  the event group before those event groups have committed, see
+  do_writeset_wait().
+
+  A hash collision only makes an event group wait without need. Conflicts
+  that can not be seen in the row images, like on a secondary unique key,
+  are still caught as in optimistic mode, by rollback and retry.
+*/
+static const uint32 rpl_writeset_history_size= 1 << 16;
+
+
+void
+rpl_parallel::writeset_start_group(rpl_group_info *rgi, bool wait)
+{
+  rpl_parallel_entry *e= rgi->parallel_entry;
+
+  DBUG_ASSERT(!writeset_entry);
+  if (!e->writeset_history &&
+      !(e->writeset_history= (uint64 *)
+        my_malloc(rpl_writeset_history_size * sizeof(uint64),
+                  MYF(MY_WME|MY_ZEROFILL))))
+  {
+    /* Run the event group as in optimistic mode. */
+    e->writeset_barrier_sub_id= rgi->gtid_sub_id;
+    return;
+  }
+
+  writeset_entry= e;
+  writeset_rgi= wait ? rgi : NULL;
+  writeset_sub_id= rgi->gtid_sub_id;
+  writeset_prior_sub_id= rgi->wait_commit_sub_id;
+  writeset_dep_sub_id= e->writeset_barrier_sub_id;
+  writeset_queued_size= 0;
+  writeset_unknown= false;
+  rgi->writeset_wait= wait;
+  rgi->writeset_done= false;
+  rgi->writeset_dep_sub_id= 0;
+}
+
+
+void
+rpl_parallel::writeset_free_tables()
+{
+  for (uint i= 0; i < writeset_tables.elements; i++)
+  {
+    rpl_writeset_table *t=
+      dynamic_element(&writeset_tables, i, rpl_writeset_table *);
+    delete t->tabledef;
+    my_free(t->pk_pos);
+  }
+  reset_dynamic(&writeset_tables);
+}
+
+
+void
+rpl_parallel::writeset_add_table(Table_map_log_event *ev)
+{
+  rpl_writeset_table t;
+  table_def *tabledef;
+  Table_map_log_event::Optional_metadata_fields
+    fields(ev->get_optional_metadata_fields());
+
+  if (!(tabledef= ev->create_table_def()))
+  {
+    writeset_unknown= true;
+    return;
+  }
+  t.table_id= ev->get_table_id();
+  t.name_hash= my_checksum(my_checksum(0, (const uchar *) ev->get_db_name(),
+                                       ev->get_db_name_len() + 1),
+                           (const uchar *) ev->get_table_name(),
+                           ev->get_table_name_len() + 1);
+  t.tabledef= tabledef;
+  t.pk_count= 0;
+  t.pk_pos= NULL;
+  if (!fields.m_primary_key.empty() &&
+      fields.m_primary_key.size() <= MAX_REF_PARTS &&
+      (t.pk_pos= (int *) my_malloc((tabledef->size() + 1) * sizeof(int),
+                                   MYF(MY_WME))))
+  {
+    for (uint i= 0; i < tabledef->size(); i++)
+      t.pk_pos[i]= -1;
+    for (uint k= 0; k < fields.m_primary_key.size(); k++)
+    {
+      uint col= fields.m_primary_key[k].first;
+      if (col >= tabledef->size() || t.pk_pos[col] >= 0)
+      {
+        /* Corrupt metadata; hash the whole row image instead. */
+        my_free(t.pk_pos);
+        t.pk_pos= NULL;
+        break;
+      }
+      t.pk_pos[col]= k;
+    }
+    if (t.pk_pos)
+      t.pk_count= (uint) fields.m_primary_key.size();
+  }
+  if (insert_dynamic(&writeset_tables, &t))
+  {
+    delete tabledef;
+    my_free(t.pk_pos);
+    writeset_unknown= true;
+  }
+}
+
+
+/*
+  Add the hash of one row image in a row event to the writeset.
+
+  @return 0 if added, 1 if the row image has no primary key value, -1 if
+  the row image could not be parsed.
+*/
+int
+rpl_parallel::writeset_add_row(const rpl_writeset_table *table,
+                               const MY_BITMAP *cols,
+                               const uchar **pos, const uchar *end)
+{
+  const uchar *null_bits= *pos;
+  const uchar *row= *pos;
+  const uchar *p= *pos + (bitmap_bits_set(cols) + 7) / 8;
+  const uchar *pk_start[MAX_REF_PARTS];
+  uint32 pk_len[MAX_REF_PARTS];
+  uint pk_found= 0, null_idx= 0;
+  uint32 hash;
+
+  if (p > end || cols->n_bits > table->tabledef->size())
+    return -1;
+  for (uint i= 0; i < cols->n_bits; i++)
+  {
+    uint32 len= 0;
+    bool is_null;
+
+    if (!bitmap_is_set(cols, i))
+      continue;
+    is_null= null_bits[null_idx / 8] & (1 << (null_idx % 8));
+    null_idx++;
+    if (!is_null &&
+        ((len= table->tabledef->calc_field_size(i, (uchar *) p)) >
+         (size_t) (end - p)))
+      return -1;
+    if (table->pk_count && table->pk_pos[i] >= 0)
+    {
+      pk_start[table->pk_pos[i]]= is_null ? NULL : p;
+      pk_len[table->pk_pos[i]]= len;
+      pk_found++;
+    }
+    p+= len;
+  }
+  *pos= p;
+
+  hash= table->name_hash;
+  if (!table->pk_count)
+    hash= my_checksum(hash, row, p - row);
+  else if (pk_found == table->pk_count)
+  {
+    for (uint k= 0; k < table->pk_count; k++)
+    {
+      uchar len_buf[4];
+      int4store(len_buf, pk_start[k] ? pk_len[k] : 0xffffffff);
+      hash= my_checksum(hash, len_buf, sizeof(len_buf));
+      if (pk_start[k])
+        hash= my_checksum(hash, pk_start[k], pk_len[k]);
+    }
+  }
+  else
+    return 1;
+
+  uint64 *slot= &writeset_entry->
+    writeset_history[hash & (rpl_writeset_history_size - 1)];
+  if (*slot > writeset_dep_sub_id && *slot < writeset_sub_id)
+    writeset_dep_sub_id= *slot;
+  *slot= writeset_sub_id;
+  return 0;
+}
+
+
+void
+rpl_parallel::writeset_add_rows(Rows_log_event *ev, Log_event_type typ)
+{
+  const rpl_writeset_table *table= NULL;
+  const uchar *p= ev->get_rows_buf();
+  const uchar *end= ev->get_rows_end();
+  bool update= LOG_EVENT_IS_UPDATE_ROW(typ);
+
+  for (uint i= writeset_tables.elements; i-- > 0; )
+  {
+    rpl_writeset_table *t=
+      dynamic_element(&writeset_tables, i, rpl_writeset_table *);
+    if (t->table_id == ev->get_table_id())
+    {
+      table= t;
+      break;
+    }
+  }
+  if (!table || !p)
+  {
+    writeset_unknown= true;
+    return;
+  }
+
+  while (p < end)
+  {
+    /*
+      The before image of an update, or the only image of other row events,
+      must identify the row. The after image of an update identifies the
+      row only if it includes the primary key.
+    */
+    if (writeset_add_row(table, ev->get_cols(), &p, end) ||
+        (update && writeset_add_row(table, ev->get_cols_ai(), &p, end) < 0))
+    {
+      writeset_unknown= true;
+      return;
+    }
+  }
+}
+
+
+/*
+  Collect the writeset of an event of the event group being queued. This
+  must be called before the event is queued for the worker.
+*/
+void
+rpl_parallel::writeset_add_event(Log_event *ev, Log_event_type typ)
+{
+  if (writeset_unknown)
+    return;
+  if (typ == TABLE_MAP_EVENT)
+    writeset_add_table(static_cast<Table_map_log_event *>(ev));
+  else if (LOG_EVENT_IS_WRITE_ROW(typ) || LOG_EVENT_IS_UPDATE_ROW(typ) ||
+           LOG_EVENT_IS_DELETE_ROW(typ))
+    writeset_add_rows(static_cast<Rows_log_event *>(ev), typ);
+  else if (LOG_EVENT_IS_QUERY(typ))
+  {
+    Query_log_event *qev= static_cast<Query_log_event *>(ev);
+    if (!qev->is_begin() && !qev->is_commit() && !qev->is_rollback())
+      writeset_unknown= true;
+  }
+  else if (typ != ANNOTATE_ROWS_EVENT && typ != XID_EVENT)
+    writeset_unknown= true;
+}
+
+
+/*
+  Complete the writeset of the event group being queued, and let the worker
+  start it once the prior event groups it depends on have committed.
+
+  If the writeset is not known, the event group depends on the prior event
+  group, and every later event group depends on it.
+*/
+void
+rpl_parallel::writeset_end_group()
+{
+  rpl_parallel_entry *e= writeset_entry;
+  uint64 dep= writeset_dep_sub_id;
+
+  if (writeset_unknown)
+  {
+    dep= writeset_prior_sub_id;
+    e->writeset_barrier_sub_id= writeset_sub_id;
+  }
+  writeset_free_tables();
+  writeset_entry= NULL;
+
+  /*
+    If the worker does not wait for the writeset, it may already have
+    completed the event group and freed the rpl_group_info.
+  */
+  if (rpl_group_info *rgi= writeset_rgi)
+  {
+    writeset_rgi= NULL;
+    mysql_mutex_lock(&e->LOCK_parallel_entry);
+    rgi->writeset_dep_sub_id= dep;
+    rgi->writeset_done= true;
+    mysql_cond_broadcast(&e->COND_parallel_entry);
+    mysql_mutex_unlock(&e->LOCK_parallel_entry);
+  }
+}
+
+
 /*
   do_event() is executed by the sql_driver_thd thread.
   It's main purpose is to find a thread that can execute the query.
@@ -2673,6 +3078,28 @@ rpl_parallel::do_event(rpl_group_info *serial_rgi, Log_event *ev,
     }
   }
 
+  /*
+    In slave_parallel_mode=writeset, collect the writeset of the event group
+    being queued. The worker does not start the event group until the
+    writeset is complete, so a too large event group is run with the prior
+    event groups committed instead, as we could otherwise block on the queue
+    size limit while the worker waits for us.
+  */
+  if (writeset_entry)
+  {
+    if (typ == GTID_EVENT || !is_group_event)
+      writeset_end_group();
+    else
+    {
+      writeset_add_event(ev, typ);
+      writeset_queued_size+= event_size;
+      if (writeset_queued_size > opt_slave_parallel_max_queued)
+        writeset_unknown= true;
+      if (writeset_unknown || is_group_ending(ev, typ))
+        writeset_end_group();
+    }
+  }
+
   if (typ == GTID_EVENT)
   {
     rpl_gtid gtid;
@@ -2834,6 +3261,23 @@ rpl_parallel::do_event(rpl_group_info *serial_rgi, Log_event *ev,
       if (gtid_flags & Gtid_log_event::FL_DDL)
         force_switch_flag= group_commit_orderer::FORCE_SWITCH;
     }
+    if (mode == SLAVE_PARALLEL_WRITESET)
+    {
+      /*
+        A standalone event group has no row events to compute a writeset
+        from; run it after prior event groups, and make it a barrier.
+      */
+      if ((gtid_flags & Gtid_log_event::FL_STANDALONE) &&
+          speculation == rpl_group_info::SPECULATE_OPTIMISTIC)
+        speculation= rpl_group_info::SPECULATE_WAIT;
+      writeset_start_group(rgi,
+                           speculation == rpl_group_info::SPECULATE_OPTIMISTIC);
+      if (writeset_entry && (gtid_flags & Gtid_log_event::FL_STANDALONE))
+      {
+        writeset_unknown= true;
+        writeset_end_group();
+      }
+    }
     rgi->speculation= speculation;
 
     if (gtid_flags & Gtid_log_event::FL_GROUP_COMMIT_ID)
@@ -10,6 +10,7 @@ struct rpl_parallel_thread_pool;
 
 class Relay_log_info;
 struct inuse_relaylog;
+class table_def;
 
 
 /*
@@ -136,6 +137,8 @@ struct rpl_parallel_thread {
     ulonglong event_relay_log_pos;
     my_off_t future_event_master_log_pos;
     size_t event_size;
+    /* Rows of the event were read ahead, see prefetch_queued_rows(). */
+    bool prefetched;
   } *event_queue, *last_in_queue;
   uint64 queued_size;
   /* These free lists are protected by LOCK_rpl_thread. */
@@ -343,16 +346,54 @@ struct rpl_parallel_entry {
   uint64 count_committing_event_groups;
   /* The group_commit_orderer object for the events currently being queued. */
   group_commit_orderer *current_gco;
+  /*
+    For slave_parallel_mode=writeset: the sub_id of the last event group that
+    changed a row, indexed by a hash of the row, see
+    rpl_parallel::writeset_add_event(). And the sub_id of the last event
+    group whose writeset is not known, which every later event group must
+    wait for. Only used by the SQL driver thread.
+  */
+  uint64 *writeset_history;
+  uint64 writeset_barrier_sub_id;
 
   rpl_parallel_thread * choose_thread(rpl_group_info *rgi, bool *did_enter_cond,
                                       PSI_stage_info *old_stage, bool reuse);
   int queue_master_restart(rpl_group_info *rgi,
                            Format_description_log_event *fdev);
 };
+/*
+  A table mapped in the event group whose writeset is being collected, see
+  rpl_parallel::writeset_add_event().
+*/
+struct rpl_writeset_table {
+  ulonglong table_id;
+  /* Hash of the database and table name. */
+  uint32 name_hash;
+  /* Number of primary key columns, 0 if not known. */
+  uint pk_count;
+  /* For each column, its position in the primary key, or -1. */
+  int *pk_pos;
+  table_def *tabledef;
+};
+
+
 struct rpl_parallel {
   HASH domain_hash;
   rpl_parallel_entry *current;
   bool sql_thread_stopping;
+  /*
+    For slave_parallel_mode=writeset: the event group being queued whose
+    writeset is being collected, and the tables mapped in it so far.
+  */
+  rpl_parallel_entry *writeset_entry;
+  rpl_group_info *writeset_rgi;
+  uint64 writeset_sub_id;
+  uint64 writeset_prior_sub_id;
+  /* The largest sub_id of a prior event group changing the same rows. */
+  uint64 writeset_dep_sub_id;
+  ulonglong writeset_queued_size;
+  bool writeset_unknown;
+  DYNAMIC_ARRAY writeset_tables;
 
   rpl_parallel();
   ~rpl_parallel();
@@ -363,6 +404,15 @@ struct rpl_parallel {
   bool workers_idle();
   int wait_for_workers_idle(THD *thd);
   int do_event(rpl_group_info *serial_rgi, Log_event *ev, ulonglong event_size);
+  void writeset_start_group(rpl_group_info *rgi, bool wait);
+  void writeset_add_event(Log_event *ev, Log_event_type typ);
+  void writeset_end_group();
+private:
+  void writeset_add_table(Table_map_log_event *ev);
+  void writeset_add_rows(Rows_log_event *ev, Log_event_type typ);
+  int writeset_add_row(const rpl_writeset_table *table, const MY_BITMAP *cols,
+                       const uchar **pos, const uchar *end);
+  void writeset_free_tables();
 };
 
 
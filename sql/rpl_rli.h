@@ -801,6 +801,16 @@ struct rpl_group_info
     */
     SPECULATE_WAIT
   } speculation;
+  /*
+    In slave_parallel_mode=writeset, set by the SQL driver thread when the
+    worker must wait before starting the event group until writeset_done is
+    set, and the event group with sub_id writeset_dep_sub_id (the last prior
+    one that changed the same rows) has committed. writeset_done and
+    writeset_dep_sub_id are protected by parallel_entry->LOCK_parallel_entry.
+  */
+  bool writeset_wait;
+  bool writeset_done;
+  uint64 writeset_dep_sub_id;
   enum enum_retry_killed {
     RETRY_KILL_NONE = 0,
     RETRY_KILL_PENDING,
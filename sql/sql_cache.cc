@@ -19,7 +19,7 @@
 
 1. Query_cache object consists of
 	- query cache memory pool (cache)
-	- queries hash (queries)
+	- queries hash, partitioned by the hash value of the query (shards)
 	- tables hash (tables)
 	- list of blocks ordered as they allocated in memory
 (first_block)
@@ -302,6 +302,19 @@ The query cache interfaces with the rest of the server code through 7
          the used memory blocks in physical memory order and move all avail-
          able memory to the 'bottom' of the memory.
 
+8. Lookups without the cache lock
+The queries hash is split into QUERY_CACHE_QUERY_SHARDS shards, each with
+its own rwlock. Threads that own the query cache lock change a shard only
+while holding its lock for writing. send_result_to_client() first tries
+Query_cache::find_cached_query(), which holds only the shard lock for
+reading while it finds the query, locks the query block for reading
+(without waiting) and checks the privileges and the engines. Cache hits
+on complete results thus never wait for structure_guard_mutex or for
+another hit; all other cases fall back to the lookup under the cache
+lock. pack_cache() locks all shards, as it moves the table blocks that
+such lookups read. The memory pool and its bins are shared by all
+shards, so storing and invalidating queries is still serialized by the
+cache lock.
 
 TODO list:
 
@@ -945,6 +958,25 @@ inline void Query_cache_query::lock_reading()
 }
 
 
+/*
+  Needed for serving a hit without the query cache lock, see
+  Query_cache::find_cached_query(). A query that is locked for
+  writing is being changed or freed and is not waited for.
+*/
+
+bool Query_cache_query::try_lock_reading()
+{
+  DBUG_ENTER("Query_cache_block::try_lock_reading");
+  if (mysql_rwlock_tryrdlock(&lock) != 0)
+  {
+    DBUG_PRINT("info", ("can't lock rwlock"));
+    DBUG_RETURN(0);
+  }
+  DBUG_PRINT("info", ("rwlock %p locked", &lock));
+  DBUG_RETURN(1);
+}
+
+
 inline void Query_cache_query::unlock_writing()
 {
   RW_UNLOCK(&lock);
@@ -1273,8 +1305,8 @@ Query_cache::Query_cache(size_t query_cache_limit_arg,
 			 uint def_table_hash_size_arg)
   :query_cache_size(0),
    query_cache_limit(query_cache_limit_arg),
-   queries_in_cache(0), hits(0), inserts(0), refused(0),
-   total_blocks(0), lowmem_prunes(0),
+   queries_in_cache(0), inserts(0), refused(0),
+   total_blocks(0), lowmem_prunes(0), hits(0),
    m_cache_status(OK),
    min_allocation_unit(ALIGN_SIZE(min_allocation_unit_arg)),
    min_result_data_size(ALIGN_SIZE(min_result_data_size_arg)),
@@ -1300,6 +1332,7 @@ size_t Query_cache::resize(size_t query_cache_size_arg)
   DBUG_ASSERT(initialized);
 
   lock_and_suspend();
+  free_query_shards();
 
   /*
     Wait for all readers and writers to exit. When the list of all queries
@@ -1521,9 +1554,14 @@ def_week_frmt: %zu, in_trans: %d, autocommit: %d",
     memcpy((void*) (query + (tot_length - QUERY_CACHE_FLAGS_SIZE)),
 	   &flags, QUERY_CACHE_FLAGS_SIZE);
 
+    my_hash_value_type hash_value= query_hash_value((uchar*) query,
+                                                    tot_length);
+    Query_cache_shard *shard= query_shard(hash_value);
+
     /* Check if another thread is processing the same query? */
     Query_cache_block *competitor = (Query_cache_block *)
-      my_hash_search(&queries, (uchar*) query, tot_length);
+      my_hash_search_using_hash_value(&shard->queries, hash_value,
+                                      (uchar*) query, tot_length);
     DBUG_PRINT("qcache", ("competitor %p", competitor));
     if (competitor == 0)
     {
@@ -1539,7 +1577,14 @@ def_week_frmt: %zu, in_trans: %d, autocommit: %d",
 
 	Query_cache_query *header = query_block->query();
 	header->init_n_lock();
-	if (my_hash_insert(&queries, (uchar*) query_block))
+        /*
+          The new query is locked for writing, so it is not used by
+          lookups before its result is stored.
+        */
+        mysql_rwlock_wrlock(&shard->lock);
+        my_bool error= my_hash_insert(&shard->queries, (uchar*) query_block);
+        mysql_rwlock_unlock(&shard->lock);
+	if (error)
 	{
 	  refused++;
 	  DBUG_PRINT("qcache", ("insertion in query hash"));
@@ -1552,7 +1597,9 @@ def_week_frmt: %zu, in_trans: %d, autocommit: %d",
 	{
 	  refused++;
 	  DBUG_PRINT("warning", ("tables list including failed"));
-	  my_hash_delete(&queries, (uchar *) query_block);
+          mysql_rwlock_wrlock(&shard->lock);
+	  my_hash_delete(&shard->queries, (uchar *) query_block);
+          mysql_rwlock_unlock(&shard->lock);
 	  header->unlock_n_destroy();
 	  free_memory_block(query_block);
           unlock();
@@ -1682,6 +1729,123 @@ size_t build_normalized_name(char *buff, size_t bufflen,
 }
 
 
+/**
+  Look up a complete cached result without the query cache lock.
+
+  Only the shard of the query is locked, for reading, while the query
+  is found and the privileges and the engines are checked, so hits do
+  not serialize on structure_guard_mutex. Anything unusual (a result
+  being stored, the query being freed, temporary tables, column
+  privileges, an engine refusing the cached result) is left to the
+  lookup under the query cache lock in send_result_to_client().
+
+  @param thd         Thread handler
+  @param key         Query, database and flags, as in the queries hash
+  @param key_length  Length of the key
+
+  @return the query block locked for reading, or NULL
+*/
+
+Query_cache_block *
+Query_cache::find_cached_query(THD *thd, const char *key, size_t key_length)
+{
+  my_hash_value_type hash_value= query_hash_value((uchar*) key, key_length);
+  Query_cache_shard *shard= query_shard(hash_value);
+  Query_cache_block *query_block;
+  Query_cache_block_table *block_table, *block_table_end;
+  Query_cache_query *query;
+  DBUG_ENTER("Query_cache::find_cached_query");
+
+  mysql_rwlock_rdlock(&shard->lock);
+  if (!my_hash_inited(&shard->queries) ||
+      !(query_block= (Query_cache_block *)
+        my_hash_search_using_hash_value(&shard->queries, hash_value,
+                                        (uchar*) key, key_length)) ||
+      !query_block->query()->try_lock_reading())
+  {
+    mysql_rwlock_unlock(&shard->lock);
+    DBUG_RETURN(0);
+  }
+
+  query= query_block->query();
+  if (query->result() == 0 ||
+      query->result()->type != Query_cache_block::RESULT ||
+      (thd->in_multi_stmt_transaction_mode() &&
+       (query->tables_type() & HA_CACHE_TBL_TRANSACT)))
+    goto miss;
+
+  block_table= query_block->table(0);
+  block_table_end= block_table + query_block->n_tables;
+  for (; block_table != block_table_end; block_table++)
+  {
+    Query_cache_table *table= block_table->parent;
+
+    if (thd->find_tmp_table_share_w_base_key((char *) table->data(),
+                                             table->key_length()))
+      goto miss;
+
+#ifndef NO_EMBEDDED_ACCESS_CHECKS
+    TABLE_LIST table_list;
+    bzero((char*) &table_list, sizeof(table_list));
+    table_list.db.str= table->db();
+    table_list.db.length= strlen(table_list.db.str);
+    table_list.alias.str= table_list.table_name.str= table->table();
+    table_list.alias.length= table_list.table_name.length=
+      strlen(table->table());
+    if (check_table_access(thd, SELECT_ACL, &table_list, FALSE, 1, TRUE) ||
+        table_list.grant.want_privilege)
+      goto miss;
+#endif /*!NO_EMBEDDED_ACCESS_CHECKS*/
+
+    if (table->callback())
+    {
+      char qcache_se_key_name[FN_REFLEN + 10];
+      size_t qcache_se_key_len, db_length= strlen(table->db());
+      ulonglong engine_data= table->engine_data();
+
+      qcache_se_key_len= build_normalized_name(qcache_se_key_name,
+                                               sizeof(qcache_se_key_name),
+                                               table->db(),
+                                               db_length,
+                                               table->table(),
+                                               table->key_length() -
+                                               db_length - 2 -
+                                               table->suffix_length(),
+                                               table->suffix_length());
+      if (!(*table->callback())(thd, qcache_se_key_name,
+                                (uint) qcache_se_key_len, &engine_data))
+      {
+        DBUG_ASSERT(! thd->transaction_rollback_request);
+        trans_rollback_stmt(thd);
+        goto miss;
+      }
+    }
+  }
+  mysql_rwlock_unlock(&shard->lock);
+  DEBUG_SYNC(thd, "query_cache_hit_without_lock");
+
+  hits++;
+  /*
+    Move the query to the end of the eviction list now and then, if
+    nobody owns the query cache lock at the moment.
+  */
+  if (query->increment_hits() % QUERY_CACHE_HITS_PER_LRU_MOVE == 1 &&
+      !mysql_mutex_trylock(&structure_guard_mutex))
+  {
+    if (m_cache_lock_status == Query_cache::UNLOCKED)
+      move_to_query_list_end(query_block);
+    mysql_mutex_unlock(&structure_guard_mutex);
+  }
+  DBUG_PRINT("qcache", ("Query %p served without the cache lock", query));
+  DBUG_RETURN(query_block);
+
+miss:
+  BLOCK_UNLOCK_RD(query_block);
+  mysql_rwlock_unlock(&shard->lock);
+  DBUG_RETURN(0);
+}
+
+
 /*
   Check if the query is in the cache. If it was cached, send it
   to the user.
@@ -1869,21 +2033,6 @@ Query_cache::send_result_to_client(THD *thd, char *org_sql, uint query_length)
       goto err;
     }
   }
-  /*
-    Try to obtain an exclusive lock on the query cache. If the cache is
-    disabled or if a full cache flush is in progress, the attempt to
-    get the lock is aborted.
-
-    The TIMEOUT parameter indicate that the lock is allowed to timeout.
-  */
-  if (try_lock(thd, Query_cache::TIMEOUT))
-    goto err;
-
-  if (query_cache_size == 0)
-  {
-    thd->query_cache_is_applicable= 0;            // Query can't be cached
-    goto err_unlock;
-  }
 
   Query_cache_block *query_block;
   if (thd->variables.query_cache_strip_comments)
@@ -1972,14 +2121,46 @@ def_week_frmt: %zu, in_trans: %d, autocommit: %d",
   memcpy((uchar *)(sql + (tot_length - QUERY_CACHE_FLAGS_SIZE)),
 	 (uchar*) &flags, QUERY_CACHE_FLAGS_SIZE);
 
+  /* Serve a complete result without the query cache lock, if possible */
+#ifdef WITH_WSREP
+  if (!(WSREP_CLIENT(thd) && wsrep_must_sync_wait(thd)))
+#endif /* WITH_WSREP */
+  if ((query_block= find_cached_query(thd, sql, tot_length)))
+  {
+    query= query_block->query();
+    result_block= query->result();
+#ifndef EMBEDDED_LIBRARY
+    first_result_block= result_block;
+#endif
+    goto send_result;
+  }
+
+  /*
+    Try to obtain an exclusive lock on the query cache. If the cache is
+    disabled or if a full cache flush is in progress, the attempt to
+    get the lock is aborted.
+
+    The TIMEOUT parameter indicate that the lock is allowed to timeout.
+  */
+  if (try_lock(thd, Query_cache::TIMEOUT))
+    goto err;
+
+  if (query_cache_size == 0)
+  {
+    thd->query_cache_is_applicable= 0;            // Query can't be cached
+    goto err_unlock;
+  }
+
 #ifdef WITH_WSREP
   bool once_more;
   once_more= true;
 lookup:
 #endif /* WITH_WSREP */
 
-  query_block = (Query_cache_block *)  my_hash_search(&queries, (uchar*) sql,
-                                                      tot_length);
+  query_block = (Query_cache_block *)
+    my_hash_search(&query_shard(query_hash_value((uchar*) sql,
+                                                 tot_length))->queries,
+                   (uchar*) sql, tot_length);
   /* Quick abort on unlocked data */
   if (query_block == 0 ||
       query_block->query()->result() == 0 ||
@@ -2153,6 +2334,7 @@ def_week_frmt: %zu, in_trans: %d, autocommit: %d",
   query->increment_hits();
   unlock();
 
+send_result:
   /*
     Send cached result to client
   */
@@ -2513,6 +2695,8 @@ void Query_cache::destroy()
 
     mysql_cond_destroy(&COND_cache_status_changed);
     mysql_mutex_destroy(&structure_guard_mutex);
+    for (uint i= 0; i < QUERY_CACHE_QUERY_SHARDS; i++)
+      mysql_rwlock_destroy(&shards[i].lock);
     initialized = 0;
     DBUG_ASSERT(m_requests_in_progress == 0);
   }
@@ -2544,6 +2728,8 @@ void Query_cache::init()
                    &structure_guard_mutex, MY_MUTEX_INIT_FAST);
   mysql_cond_init(key_COND_cache_status_changed,
                   &COND_cache_status_changed, NULL);
+  for (uint i= 0; i < QUERY_CACHE_QUERY_SHARDS; i++)
+    mysql_rwlock_init(key_rwlock_query_cache_shard_lock, &shards[i].lock);
   m_cache_lock_status= Query_cache::UNLOCKED;
   m_cache_status= Query_cache::OK;
   m_requests_in_progress= 0;
@@ -2727,8 +2913,12 @@ size_t Query_cache::init_cache()
 
   DUMP(this);
 
-  (void) my_hash_init(&queries, &my_charset_bin, def_query_hash_size, 0, 0,
-                      query_cache_query_get_key, 0, 0);
+  lock_query_shards();
+  for (uint i= 0; i < QUERY_CACHE_QUERY_SHARDS; i++)
+    (void) my_hash_init(&shards[i].queries, &my_charset_bin,
+                        def_query_hash_size / QUERY_CACHE_QUERY_SHARDS, 0, 0,
+                        query_cache_query_get_key, 0, 0);
+  unlock_query_shards();
 #ifndef FN_NO_CASE_SENSE
   /*
     If lower_case_table_names!=0 then db and table names are already 
@@ -2788,6 +2978,57 @@ void Query_cache::make_disabled()
 }
 
 
+/* The shard of the queries hash that holds the query */
+
+Query_cache_shard *Query_cache::query_shard(Query_cache_block *query_block)
+{
+  size_t length;
+  uchar *key= query_cache_query_get_key((uchar*) query_block, &length, 0);
+  return query_shard(query_hash_value(key, length));
+}
+
+
+/*
+  Lock all shards of the queries hash for writing. Requires the query
+  cache lock, which serializes the threads that lock shards for writing.
+*/
+
+void Query_cache::lock_query_shards()
+{
+  for (uint i= 0; i < QUERY_CACHE_QUERY_SHARDS; i++)
+    mysql_rwlock_wrlock(&shards[i].lock);
+}
+
+
+void Query_cache::unlock_query_shards()
+{
+  for (uint i= 0; i < QUERY_CACHE_QUERY_SHARDS; i++)
+    mysql_rwlock_unlock(&shards[i].lock);
+}
+
+
+/* Remove all queries from the queries hash */
+
+void Query_cache::reset_query_shards()
+{
+  lock_query_shards();
+  for (uint i= 0; i < QUERY_CACHE_QUERY_SHARDS; i++)
+    my_hash_reset(&shards[i].queries);
+  unlock_query_shards();
+}
+
+
+/* Free the queries hash, init_cache() creates it again */
+
+void Query_cache::free_query_shards()
+{
+  lock_query_shards();
+  for (uint i= 0; i < QUERY_CACHE_QUERY_SHARDS; i++)
+    my_hash_free(&shards[i].queries);
+  unlock_query_shards();
+}
+
+
 /**
   @class Query_cache
   Free all resources allocated by the cache.
@@ -2805,6 +3046,9 @@ void Query_cache::free_cache()
   DBUG_ASSERT(m_cache_lock_status == LOCKED_NO_WAIT ||
               m_cache_status == DISABLE_REQUEST);
 
+  /* Stop lookups without the cache lock before destroying the queries */
+  free_query_shards();
+
   /* Destroy locks */
   Query_cache_block *block= queries_blocks;
   if (block)
@@ -2833,7 +3077,6 @@ void Query_cache::free_cache()
 #endif
   my_free(cache);
   make_disabled();
-  my_hash_free(&queries);
   my_hash_free(&tables);
   DBUG_VOID_RETURN;
 }
@@ -2860,7 +3103,7 @@ void Query_cache::flush_cache()
 {
   QC_DEBUG_SYNC("wait_in_query_cache_flush2");
 
-  my_hash_reset(&queries);
+  reset_query_shards();
   while (queries_blocks != 0)
   {
     BLOCK_LOCK_WR(queries_blocks);
@@ -3007,7 +3250,10 @@ void Query_cache::free_query(Query_cache_block *query_block)
 		      query_block,
 		      query_block->query()->length() ));
 
-  my_hash_delete(&queries,(uchar *) query_block);
+  Query_cache_shard *shard= query_shard(query_block);
+  mysql_rwlock_wrlock(&shard->lock);
+  my_hash_delete(&shard->queries, (uchar *) query_block);
+  mysql_rwlock_unlock(&shard->lock);
   free_query_internal(query_block);
 
   DBUG_VOID_RETURN;
@@ -4246,6 +4492,11 @@ void Query_cache::pack_cache()
 
   if (first_block)
   {
+    /*
+      Lookups without the cache lock read the table blocks of a query
+      while holding the shard lock, and table blocks are moved here.
+    */
+    lock_query_shards();
     do
     {
       Query_cache_block *next=block->pnext;
@@ -4264,6 +4515,7 @@ void Query_cache::pack_cache()
       new_block->pnext->pprev = new_block;
       insert_into_free_memory_list(new_block);
     }
+    unlock_query_shards();
     DUMP(this);
   }
 
@@ -4378,7 +4630,8 @@ my_bool Query_cache::move_by_type(uchar **border,
     uchar *key;
     size_t key_length;
     key=query_cache_query_get_key((uchar*) block, &key_length, 0);
-    my_hash_first(&queries, (uchar*) key, key_length, &record_idx);
+    HASH *queries= &query_shard(query_hash_value(key, key_length))->queries;
+    my_hash_first(queries, (uchar*) key, key_length, &record_idx);
     block->query()->unlock_n_destroy();
     block->destroy();
     // Move table of used tables
@@ -4446,7 +4699,7 @@ my_bool Query_cache::move_by_type(uchar **border,
       query_cache_tls->first_query_block= new_block;
     }
     /* Fix hash to point at moved block */
-    my_hash_replace(&queries, &record_idx, (uchar*) new_block);
+    my_hash_replace(queries, &record_idx, (uchar*) new_block);
     DBUG_PRINT("qcache", ("moved %zu bytes to %p, new gap at %p",
 			len, new_block, *border));
     break;
@@ -4857,10 +5110,13 @@ my_bool Query_cache::check_integrity(bool locked)
   if (!locked)
     lock_and_suspend();
 
-  if (my_hash_check(&queries))
+  for (i= 0; i < QUERY_CACHE_QUERY_SHARDS; i++)
   {
-    DBUG_PRINT("error", ("queries hash is damaged"));
-    result = 1;
+    if (my_hash_check(&shards[i].queries))
+    {
+      DBUG_PRINT("error", ("queries hash %u is damaged", i));
+      result = 1;
+    }
   }
 
   if (my_hash_check(&tables))
@@ -5030,7 +5286,7 @@ my_bool Query_cache::check_integrity(bool locked)
 			    block, (uint) block->type));
       size_t length;
       uchar *key = query_cache_query_get_key((uchar*) block, &length, 0);
-      uchar* val = my_hash_search(&queries, key, length);
+      uchar* val = my_hash_search(&query_shard(block)->queries, key, length);
       if (((uchar*)block) != val)
       {
 	DBUG_PRINT("error", ("block %p found in queries hash like %p",
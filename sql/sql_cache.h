@@ -18,6 +18,7 @@
 
 #include "hash.h"
 #include "my_base.h"                            /* ha_rows */
+#include "my_counter.h"
 
 class MY_LOCALE;
 struct TABLE_LIST;
@@ -40,6 +41,15 @@ typedef struct st_changed_table_list CHANGED_TABLE_LIST;
 #define QUERY_CACHE_DEF_QUERY_HASH_SIZE		1024
 #define QUERY_CACHE_DEF_TABLE_HASH_SIZE		1024
 
+/* number of partitions of the queries hash, must be a power of 2 */
+#define QUERY_CACHE_QUERY_SHARDS		16
+
+/*
+  how often a query served without the cache lock is moved to the end of
+  the list of queries to free
+*/
+#define QUERY_CACHE_HITS_PER_LRU_MOVE		16
+
 /* minimal result data size when data allocated */
 #define QUERY_CACHE_MIN_RESULT_DATA_SIZE	(1024*4)
 
@@ -159,7 +169,7 @@ struct Query_cache_query
   unsigned int last_pkt_nr;
   uint8 tbls_type;
   uint8 ready;
-  ulonglong hit_count;
+  Atomic_counter<ulonglong> hit_count;
 
   Query_cache_query() {}                      /* Remove gcc warning */
   inline void init_n_lock();
@@ -185,10 +195,11 @@ struct Query_cache_query
   */
   inline void set_results_ready()          { ready= 1; }
   inline bool is_results_ready()           { return ready; }
-  inline void increment_hits() { hit_count++; }
+  inline ulonglong increment_hits() { return ++hit_count; }
   inline ulonglong hits() { return hit_count; }
   void lock_writing();
   void lock_reading();
+  bool try_lock_reading();
   bool try_lock_writing();
   void unlock_writing();
   void unlock_reading();
@@ -297,14 +308,31 @@ struct Query_cache_memory_bin_step
   }
 };
 
+/**
+  A partition of the queries hash.
+
+  The hash is changed only by threads that own the query cache lock
+  (Query_cache::try_lock()) and hold the shard lock for writing, so such
+  threads may search it without the shard lock. Cache hits are looked
+  up with only the shard lock held for reading, see
+  Query_cache::send_result_to_client().
+*/
+struct Query_cache_shard
+{
+  mysql_rwlock_t lock;
+  HASH queries;
+} MY_ALIGNED(CPU_LEVEL1_DCACHE_LINESIZE);
+
 class Query_cache
 {
 public:
   /* Info */
   size_t query_cache_size, query_cache_limit;
   /* statistics */
-  size_t free_memory, queries_in_cache, hits, inserts, refused,
+  size_t free_memory, queries_in_cache, inserts, refused,
     free_memory_blocks, total_blocks, lowmem_prunes;
+  /* updated without the cache lock by send_result_to_client() */
+  Atomic_counter<size_t> hits;
 
 
 private:
@@ -321,6 +349,22 @@ class Query_cache
   void free_query_internal(Query_cache_block *point);
   void invalidate_table_internal(THD *thd, uchar *key, size_t key_length);
 
+  /* All shards use my_charset_bin, see init_cache() */
+  my_hash_value_type query_hash_value(const uchar *key, size_t length)
+  { return my_hash_sort(&my_charset_bin, key, length); }
+  Query_cache_shard *query_shard(my_hash_value_type hash_value)
+  {
+    /* The low bits select the bucket inside of the shard */
+    return &shards[(hash_value >> 24) & (QUERY_CACHE_QUERY_SHARDS - 1)];
+  }
+  Query_cache_shard *query_shard(Query_cache_block *query_block);
+  void lock_query_shards();
+  void unlock_query_shards();
+  void reset_query_shards();
+  void free_query_shards();
+  Query_cache_block *find_cached_query(THD *thd, const char *key,
+                                       size_t key_length);
+
 protected:
   /*
     The following mutex is locked when searching or changing global
@@ -329,6 +373,11 @@ class Query_cache
     LOCK SEQUENCE (to prevent deadlocks):
       1. structure_guard_mutex
       2. query block (for operation inside query (query block/results))
+    Query_cache_shard::lock is locked for writing only by the owner of
+    the cache lock, which may already hold a query block lock. Lookups
+    without the cache lock take the shard lock for reading and then only
+    try to lock the query block, see find_cached_query(), so they never
+    wait for a query block while holding a shard lock.
 
     Thread doing cache flush releases the mutex once it sets
     m_cache_lock_status flag, so other threads may bypass the cache as
@@ -345,7 +394,8 @@ class Query_cache
 
   Query_cache_memory_bin *bins;			// free block lists
   Query_cache_memory_bin_step *steps;		// bins spacing info
-  HASH queries, tables;
+  Query_cache_shard shards[QUERY_CACHE_QUERY_SHARDS];
+  HASH tables;
   /* options */
   size_t min_allocation_unit, min_result_data_size;
   uint def_query_hash_size, def_table_hash_size;
@@ -627,6 +627,9 @@ class Explain_rowid_filter : public Sql_alloc
   /* Expected selectivity for the filter */
   double selectivity;
 
+  /* TRUE <=> the filter is a bloom filter rather than a sorted array */
+  bool bloom_filter;
+
   /* Tracker with the information about how rowid filter is executed */
   Rowid_filter_tracker *tracker;
 
@@ -2695,7 +2695,7 @@ int JOIN_CACHE_HASHED::init(bool for_explain)
   ref_key_info= join_tab->get_keyinfo_by_key_no(join_tab->ref.key);
   ref_used_key_parts= join_tab->ref.key_parts;
 
-  hash_func= &JOIN_CACHE_HASHED::get_hash_idx_simple;
+  hash_func= &JOIN_CACHE_HASHED::get_hash_simple;
   hash_cmp_func= &JOIN_CACHE_HASHED::equal_keys_simple;
 
   KEY_PART_INFO *key_part= ref_key_info->key_part;
@@ -2704,7 +2704,7 @@ int JOIN_CACHE_HASHED::init(bool for_explain)
   {
     if (!key_part->field->eq_cmp_as_binary())
     {
-      hash_func= &JOIN_CACHE_HASHED::get_hash_idx_complex;
+      hash_func= &JOIN_CACHE_HASHED::get_hash_complex;
       hash_cmp_func= &JOIN_CACHE_HASHED::equal_keys_complex;
       break;
     }
@@ -2771,13 +2771,20 @@ int JOIN_CACHE_HASHED::init_hash_table()
                              key_entry_length+size_of_key_ofs);
 
     hash_entries= (uint) (n / 0.7);
-    set_if_bigger(hash_entries, 1);
+    set_if_bigger(hash_entries, 2);
     
     if (offset_size((uint)(max_n*key_entry_length)) <=
         size_of_key_ofs)
       break;
   }
    
+  /*
+    Keep at least 1/8 of the hash entries free. One more key entry
+    can be added after the buffer has been reported full (see
+    JOIN_CACHE::join_matching_records()), so reserve one more entry.
+  */
+  max_key_entries= hash_entries - hash_entries/8 - 1;
+
   /* Initialize the hash table */ 
   hash_table= buff + (buff_size-hash_entries*size_of_key_ofs);
   cleanup_hash_table();
@@ -2897,6 +2904,8 @@ void JOIN_CACHE_HASHED::reset(bool for_writing)
     the record from the partial join.
     If the match flag field of a record contains MATCH_IMPOSSIBLE the key is
     not created for this record. 
+    The buffer is reported as full when the number of key entries reaches
+    max_key_entries, as the hash table must never be filled up completely.
     
   RETURN VALUE
     TRUE    if it has been decided that it should be the last record
@@ -2910,6 +2919,7 @@ bool JOIN_CACHE_HASHED::put_record()
   uchar *key;
   uint key_len= key_length;
   uchar *key_ref_ptr;
+  ulong hash_tag;
   uchar *link= 0;
   TABLE_REF *ref= &join_tab->ref;
   uchar *next_ref_ptr= pos;
@@ -2933,7 +2943,7 @@ bool JOIN_CACHE_HASHED::put_record()
   }
 
   /* Look for the key in the hash table */
-  if (key_search(key, key_len, &key_ref_ptr))
+  if (key_search(key, key_len, &key_ref_ptr, &hash_tag))
   {
     uchar *last_next_ref_ptr;
     /* 
@@ -2955,14 +2965,15 @@ bool JOIN_CACHE_HASHED::put_record()
   {
     /* 
       The key is not found in the hash table.
-      Put the key into the join buffer linking it with the keys for the
-      corresponding hash entry. Create a circular list with one element
+      Put the key into the join buffer referring to it from the free
+      hash entry found for it. Create a circular list with one element
       referencing the record and attach the list to the key in the buffer.
     */
     uchar *cp= last_key_entry;
+    DBUG_ASSERT(is_null_key_ref(key_ref_ptr));
     cp-= get_size_of_rec_offset()+get_size_of_key_offset();
     store_next_key_ref(key_ref_ptr, cp);
-    store_null_key_ref(cp);
+    store_offset(get_size_of_key_offset(), cp, hash_tag);
     store_next_rec_ref(next_ref_ptr, next_ref_ptr);
     store_next_rec_ref(cp+get_size_of_key_offset(), next_ref_ptr);
     if (use_emb_key)
@@ -2979,6 +2990,8 @@ bool JOIN_CACHE_HASHED::put_record()
     DBUG_ASSERT(last_key_entry >= end_pos);
     /* Increment the counter of key_entries in the hash table */ 
     key_entries++;
+    if (key_entries >= max_key_entries)
+      is_full= TRUE;
   }  
   return is_full;
 }
@@ -3072,18 +3085,23 @@ bool JOIN_CACHE_HASHED::skip_if_not_needed_match()
     key_search()
       key             pointer to the key value
       key_len         key value length
-      key_ref_ptr OUT position of the reference to the next key from 
-                      the hash element for the found key , or
-                      a position where the reference to the the hash 
-                      element for the key is to be added in the
-                      case when the key has not been found
+      key_ref_ptr OUT position of the hash tag from the key entry for
+                      the found key, or the position of the free
+                      hash entry where the reference to the key entry
+                      for the key is to be added in the case when
+                      the key has not been found
+      hash_tag    OUT if not NULL, the hash tag of the key
       
   DESCRIPTION
     The function looks for a key in the hash table of the join buffer.
-    If the key is found the functionreturns the position of the reference
-    to the next key from  to the hash element for the given key. 
-    Otherwise the function returns the position where the reference to the
-    newly created hash element for the given key is to be added.  
+    Starting from the hash entry for the hash value of the key it scans
+    the hash entries until it finds the key entry with the given key or
+    a free hash entry. The key values are compared only for the key
+    entries whose hash tags coincide with the hash tag of the key.
+    If the key is found the function returns the position of the hash
+    tag from the key entry for the given key. Otherwise the function
+    returns the position of the free hash entry where the reference to
+    the newly created key entry for the given key is to be added.
 
   RETURN VALUE
     TRUE    the key is found in the hash table
@@ -3091,25 +3109,37 @@ bool JOIN_CACHE_HASHED::skip_if_not_needed_match()
 */
 
 bool JOIN_CACHE_HASHED::key_search(uchar *key, uint key_len,
-                                   uchar **key_ref_ptr) 
+                                   uchar **key_ref_ptr, ulong *hash_tag)
 {
   bool is_found= FALSE;
-  uint idx= (this->*hash_func)(key, key_length);
+  ulong nr= (this->*hash_func)(key, key_length);
+  ulong tag= get_hash_tag(nr);
+  uint idx= (uint) (nr % hash_entries);
   uchar *ref_ptr= hash_table+size_of_key_ofs*idx;
-  while (!is_null_key_ref(ref_ptr))
+  uchar *hash_table_end= hash_table+size_of_key_ofs*hash_entries;
+  for (uint i= 0; i < hash_entries && !is_null_key_ref(ref_ptr); i++)
   {
-    uchar *next_key;
-    ref_ptr= get_next_key_ref(ref_ptr);
-    next_key= use_emb_key ? get_emb_key(ref_ptr-get_size_of_rec_offset()) :
-                            ref_ptr-key_length;
-
-    if ((this->*hash_cmp_func)(next_key, key, key_len))
+    uchar *key_ptr= get_next_key_ref(ref_ptr);
+    if (get_offset(size_of_key_ofs, key_ptr) == tag)
     {
-      is_found= TRUE;
-      break;
+      uchar *next_key= use_emb_key ?
+                       get_emb_key(key_ptr-get_size_of_rec_offset()) :
+                       key_ptr-key_length;
+      if ((this->*hash_cmp_func)(next_key, key, key_len))
+      {
+        ref_ptr= key_ptr;
+        is_found= TRUE;
+        break;
+      }
     }
+    /* Probe the next hash entry wrapping around the end of the table */
+    ref_ptr+= size_of_key_ofs;
+    if (ref_ptr == hash_table_end)
+      ref_ptr= hash_table;
   }
   *key_ref_ptr= ref_ptr;
+  if (hash_tag)
+    *hash_tag= tag;
   return is_found;
 } 
 
@@ -3118,21 +3148,23 @@ bool JOIN_CACHE_HASHED::key_search(uchar *key, uint key_len,
   Hash function that considers a key in the hash table as byte array
 
   SYNOPSIS
-    get_hash_idx_simple()
+    get_hash_simple()
       key             pointer to the key value
       key_len         key value length
       
   DESCRIPTION
-    The function calculates an index of the hash entry in the hash table
-    of the join buffer for the given key. It considers the key just as
-    a sequence of bytes of the length key_len.
+    The function calculates the hash value for the given key. It considers
+    the key just as a sequence of bytes of the length key_len.
+    The remainder of the division of the hash value by the number of hash
+    entries is used as the index of the hash entry for the key, while
+    the quotient is used as the hash tag of the key.
 
   RETURN VALUE
-    the calculated index of the hash entry for the given key  
+    the calculated hash value for the given key  
 */
 
 inline
-uint JOIN_CACHE_HASHED::get_hash_idx_simple(uchar* key, uint key_len)
+ulong JOIN_CACHE_HASHED::get_hash_simple(uchar* key, uint key_len)
 {
   ulong nr= 1;
   ulong nr2= 4;
@@ -3143,7 +3175,7 @@ uint JOIN_CACHE_HASHED::get_hash_idx_simple(uchar* key, uint key_len)
     nr^= (ulong) ((((uint) nr & 63)+nr2)*((uint) *pos))+ (nr << 8);
     nr2+= 3;
   }
-  return nr % hash_entries;
+  return nr;
 }
 
 
@@ -3151,14 +3183,14 @@ uint JOIN_CACHE_HASHED::get_hash_idx_simple(uchar* key, uint key_len)
   Hash function that takes into account collations of the components of the key  
 
   SYNOPSIS
-    get_hash_idx_complex()
+    get_hash_complex()
       key             pointer to the key value
       key_len         key value length
       
   DESCRIPTION
-    The function calculates an index of the hash entry in the hash table
-    of the join buffer for the given key. It takes into account that the
-    components of the key may be of a varchar type with different collations.
+    The function calculates the hash value for the given key. It takes into
+    account that the components of the key may be of a varchar type with
+    different collations.
     The function guarantees that the same hash value for any two equal
     keys that may differ as byte sequences.
     The function takes the info about the components of the key, their
@@ -3167,14 +3199,13 @@ uint JOIN_CACHE_HASHED::get_hash_idx_simple(uchar* key, uint key_len)
     operation.
 
   RETURN VALUE
-    the calculated index of the hash entry for the given key  
+    the calculated hash value for the given key  
 */
 
 inline
-uint JOIN_CACHE_HASHED::get_hash_idx_complex(uchar *key, uint key_len)
+ulong JOIN_CACHE_HASHED::get_hash_complex(uchar *key, uint key_len)
 {
-  return 
-    (uint) (key_hashnr(ref_key_info, ref_used_key_parts, key) % hash_entries);
+  return key_hashnr(ref_key_info, ref_used_key_parts, key);
 }
 
 
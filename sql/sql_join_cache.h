@@ -697,17 +697,22 @@ class JOIN_CACHE :public Sql_alloc
   at the very end of the join buffer. The array of hash entries is allocated
   first at the very bottom of the join buffer, while key entries are placed
   before this array.
-  A hash entry contains a header of the list of the key entries with the same
-  hash value. 
+  The hash table uses open addressing with linear probing: a hash entry
+  either is empty or refers to exactly one key entry, and a key whose hash
+  entry is occupied by another key is placed into the next free hash entry.
+  This way probing the table mostly touches adjacent hash entries instead of
+  following a list of key entries scattered over the join buffer.
   Each key entry is a structure of the following type:
     struct st_join_cache_key_entry {
       union { 
         uchar[] value;
         cache_ref *value_ref; // offset from the beginning of the buffer
       } hash_table_key;
-      key_ref next_key; // offset backward from the beginning of hash table
+      key_tag hash_tag; // bits of the hash value not used for the hash index
       cache_ref *last_rec // offset from the beginning of the buffer
     }
+  The hash tag allows to skip most key entries with the same hash index
+  without comparing the key values.
   The references linking the records in a chain are always placed at the very
   beginning of the record info stored in the join buffer. The records are 
   linked in a circular list. A new record is always added to the end of this 
@@ -750,6 +755,8 @@ class JOIN_CACHE :public Sql_alloc
       record_1_1
       record_1_2
       record_1_3 (points to record_1_1)
+
+  (i+1)-th hash entry (key_3 has the same hash index as key_1):
     circular record chain for key_3:
       record_3_1 (points to itself)
 
@@ -763,7 +770,7 @@ class JOIN_CACHE :public Sql_alloc
 class JOIN_CACHE_HASHED: public JOIN_CACHE
 {
 
-  typedef uint (JOIN_CACHE_HASHED::*Hash_func) (uchar *key, uint key_len);
+  typedef ulong (JOIN_CACHE_HASHED::*Hash_func) (uchar *key, uint key_len);
   typedef bool (JOIN_CACHE_HASHED::*Hash_cmp_func) (uchar *key1, uchar *key2,
                                                     uint key_len);
   
@@ -783,6 +790,11 @@ class JOIN_CACHE_HASHED: public JOIN_CACHE
   uchar *hash_table;
   /* Number of hash entries in the hash table */
   uint hash_entries;
+  /*
+    Maximum number of key entries in the hash table. The hash table must
+    always have free hash entries to keep linear probing short.
+  */
+  uint max_key_entries;
 
 
   /* The position of the currently retrieved key entry in the hash table */
@@ -791,8 +803,8 @@ class JOIN_CACHE_HASHED: public JOIN_CACHE
   /* The offset of the data fields from the beginning of the record fields */
   uint data_fields_offset;
 
-  inline uint get_hash_idx_simple(uchar *key, uint key_len);
-  inline uint get_hash_idx_complex(uchar *key, uint key_len);
+  inline ulong get_hash_simple(uchar *key, uint key_len);
+  inline ulong get_hash_complex(uchar *key, uint key_len);
 
   inline bool equal_keys_simple(uchar *key1, uchar *key2, uint key_len);
   inline bool equal_keys_complex(uchar *key1, uchar *key2, uint key_len);
@@ -850,7 +862,7 @@ class JOIN_CACHE_HASHED: public JOIN_CACHE
   uint get_size_of_key_offset() { return size_of_key_ofs; }
 
   /* 
-    Get the position of the next_key_ptr field pointed to by 
+    Get the position of the hash_tag field pointed to by 
     a linking reference stored at the position key_ref_ptr. 
     This reference is actually the offset backward from the
     beginning of hash table.
@@ -861,8 +873,8 @@ class JOIN_CACHE_HASHED: public JOIN_CACHE
   }
 
   /* 
-    Store the linking reference to the next_key_ptr field at 
-    the position key_ref_ptr. The position of the next_key_ptr
+    Store the linking reference to the hash_tag field at 
+    the position key_ref_ptr. The position of the hash_tag
     field is pointed to by ref. The stored reference is actually
     the offset backward from the beginning of the hash table.
   */  
@@ -872,7 +884,7 @@ class JOIN_CACHE_HASHED: public JOIN_CACHE
   }     
   
   /* 
-    Check whether the reference to the next_key_ptr field at the position
+    Check whether the reference to the hash_tag field at the position
     key_ref_ptr contains  a nil value.
   */
   bool is_null_key_ref(uchar *key_ref_ptr)
@@ -881,15 +893,15 @@ class JOIN_CACHE_HASHED: public JOIN_CACHE
     return memcmp(key_ref_ptr, &nil, size_of_key_ofs ) == 0;
   } 
 
-  /* 
-    Set the reference to the next_key_ptr field at the position
-    key_ref_ptr equal to nil.
+  /*
+    Get the hash tag of a key with the hash value nr. The tag is built
+    from the bits of nr that are not used to get the index of the hash entry.
   */
-  void store_null_key_ref(uchar *key_ref_ptr)
+  ulong get_hash_tag(ulong nr)
   {
-    ulong nil= 0;
-    store_offset(size_of_key_ofs, key_ref_ptr, nil);
-  } 
+    nr/= hash_entries;
+    return size_of_key_ofs == 2 ? (nr & 0xFFFF) : (nr & 0xFFFFFFFF);
+  }
 
   uchar *get_next_rec_ref(uchar *ref_ptr)
   {
@@ -970,7 +982,8 @@ class JOIN_CACHE_HASHED: public JOIN_CACHE
   bool skip_if_not_needed_match();
 
   /* Search for a key in the hash table of the join buffer */
-  bool key_search(uchar *key, uint key_len, uchar **key_ref_ptr);
+  bool key_search(uchar *key, uint key_len, uchar **key_ref_ptr,
+                  ulong *hash_tag= 0);
 
   /* Reallocate the join buffer of a hashed join cache */
   int realloc_buffer();
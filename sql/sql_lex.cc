@@ -1262,6 +1262,7 @@ void LEX::start(THD *thd_arg)
   verbose= 0;
 
   name= null_clex_str;
+  plan_cache_key= null_clex_str;
   event_parse_data= NULL;
   profile_options= PROFILE_NONE;
   nest_level= 0;
@@ -3142,6 +3142,12 @@ struct LEX: public Query_tables_list
   */
   LEX *stmt_lex;
 
+  /*
+    Key of the executed prepared statement in the plan cache, see
+    opt_plan_cache.h. Empty if the statement's join orders are not cached.
+  */
+  LEX_CSTRING plan_cache_key;
+
   LEX_CSTRING name;
   const char *help_arg;
   const char *backup_dir;                       /* For RESTORE/BACKUP */
@@ -4727,7 +4733,7 @@ class Parser_state
 {
 public:
   Parser_state()
-    : m_yacc()
+    : m_yacc(), m_digest(NULL)
   {}
 
   /**
@@ -4752,6 +4758,12 @@ class Parser_state
   */
   PSI_digest_locker* m_digest_psi;
 
+  /**
+    Digest to compute while parsing when the performance schema does not
+    compute one, or NULL.
+  */
+  sql_digest_state *m_digest;
+
   void reset(char *found_semicolon, unsigned int length)
   {
     m_lip.reset(found_semicolon, length);
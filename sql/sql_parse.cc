@@ -10286,6 +10286,13 @@ bool parse_sql(THD *thd, Parser_state *parser_state,
     }
   }
 
+  if (!parser_state->m_lip.m_digest && parser_state->m_digest)
+  {
+    /* The caller wants a digest, e.g for the plan cache */
+    parser_state->m_lip.m_digest= parser_state->m_digest;
+    parser_state->m_lip.m_digest->m_digest_storage.m_charset_number= thd->charset()->number;
+  }
+
   /* Parse the query. */
 
   bool mysql_parse_status=
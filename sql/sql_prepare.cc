@@ -113,6 +113,7 @@ When one supplies long data for a placeholder:
 #include "sql_handler.h"  // mysql_ha_rm_tables
 #include "probes_mysql.h"
 #include "opt_trace.h"
+#include "opt_plan_cache.h"
 #ifdef EMBEDDED_LIBRARY
 /* include MYSQL_BIND headers */
 #include <mysql.h>
@@ -215,8 +216,12 @@ class Prepared_statement: public Statement
   */
   MEM_ROOT main_mem_root;
   sql_mode_t m_sql_mode;
+  /* Digest of the statement, for the plan cache */
+  uchar plan_digest[MD5_HASH_SIZE];
+  bool has_plan_digest;
 private:
   bool set_db(const LEX_CSTRING *db);
+  void set_plan_cache_key();
   bool set_parameters(String *expanded_query,
                       uchar *packet, uchar *packet_end);
   bool execute(String *expanded_query, bool open_cursor);
@@ -3798,7 +3803,8 @@ Prepared_statement::Prepared_statement(THD *thd_arg)
   iterations(0),
   start_param(0),
   read_types(0),
-  m_sql_mode(thd->variables.sql_mode)
+  m_sql_mode(thd->variables.sql_mode),
+  has_plan_digest(false)
 {
   init_sql_alloc(&main_mem_root, "Prepared_statement",
                  thd_arg->variables.query_alloc_block_size,
@@ -4016,6 +4022,16 @@ bool Prepared_statement::prepare(const char *packet, uint packet_len)
   parser_state.m_lip.stmt_prepare_mode= TRUE;
   parser_state.m_lip.multi_statements= FALSE;
 
+  /* The plan cache needs the statement digest, compute it while parsing */
+  sql_digest_state digest;
+  uchar *digest_tokens= NULL;
+  if (plan_cache_size && max_digest_length &&
+      (digest_tokens= (uchar*) my_malloc(max_digest_length, MYF(0))))
+  {
+    digest.reset(digest_tokens, max_digest_length);
+    parser_state.m_digest= &digest;
+  }
+
   lex_start(thd);
   lex->context_analysis_only|= CONTEXT_ANALYSIS_ONLY_PREPARE;
 
@@ -4023,6 +4039,18 @@ bool Prepared_statement::prepare(const char *packet, uint packet_len)
           thd->is_error() ||
           init_param_array(this));
 
+  has_plan_digest= false;
+  if (digest_tokens)
+  {
+    /* A truncated digest does not identify the statement */
+    if (!error && !digest.m_digest_storage.m_full)
+    {
+      compute_digest_md5(&digest.m_digest_storage, plan_digest);
+      has_plan_digest= true;
+    }
+    my_free(digest_tokens);
+  }
+
   lex->set_trg_event_type_for_tables();
 
   /*
@@ -4616,6 +4644,9 @@ Prepared_statement::swap_prepared_statement(Prepared_statement *copy)
   swap_variables(LEX_CSTRING, name, copy->name);
   /* Ditto */
   swap_variables(LEX_CSTRING, db, copy->db);
+  /* The digest of the copy is the same, but may be missing in the old */
+  has_plan_digest= copy->has_plan_digest;
+  memcpy(plan_digest, copy->plan_digest, MD5_HASH_SIZE);
 
   DBUG_ASSERT(param_count == copy->param_count);
   DBUG_ASSERT(thd == copy->thd);
@@ -4624,6 +4655,38 @@ Prepared_statement::swap_prepared_statement(Prepared_statement *copy)
 }
 
 
+/**
+  Set the key of the statement in the plan cache for this execution,
+  see opt_plan_cache.h. The key is made of the statement digest, the
+  current database and the types of the parameters.
+*/
+
+void Prepared_statement::set_plan_cache_key()
+{
+  lex->plan_cache_key= null_clex_str;
+  if (!has_plan_digest || !plan_cache_size)
+    return;
+
+  size_t length= MD5_HASH_SIZE + db.length + 1 + param_count;
+  char *key= (char*) thd->alloc(length);
+  if (!key)
+    return;
+
+  char *pos= key;
+  memcpy(pos, plan_digest, MD5_HASH_SIZE);
+  pos+= MD5_HASH_SIZE;
+  if (db.length)
+    memcpy(pos, db.str, db.length);
+  pos+= db.length;
+  *pos++= 0;
+  for (uint i= 0; i < param_count; i++)
+    *pos++= (char) param_array[i]->field_type();
+
+  lex->plan_cache_key.str= key;
+  lex->plan_cache_key.length= length;
+}
+
+
 /**
   Execute a prepared statement.
 
@@ -4741,6 +4804,7 @@ bool Prepared_statement::execute(String *expanded_query, bool open_cursor)
   old_stmt_arena= thd->stmt_arena;
   thd->stmt_arena= this;
   reinit_stmt_before_use(thd, lex);
+  set_plan_cache_key();
 
   /* Go! */
 
@@ -4777,6 +4841,8 @@ bool Prepared_statement::execute(String *expanded_query, bool open_cursor)
       qc_executed= TRUE;
     }
   }
+  /* The key was allocated in the runtime memory root */
+  lex->plan_cache_key= null_clex_str;
 
   /*
     Restore the current database (if changed).
@@ -982,15 +982,19 @@ get_binlog_list(MEM_ROOT *memroot, bool reverse= true,
   Gtid_list_log_event where D is not present in the requested slave state at
   all. Since if D is not in requested slave state, it means that slave needs
   to start at the very first GTID in domain D.
+
+  The same check is done against the binlog state at an entry of the GTID
+  index of the binlog file, to start from the offset of that entry.
 */
 static bool
-contains_all_slave_gtid(slave_connection_state *st, Gtid_list_log_event *glev)
+contains_all_slave_gtid(slave_connection_state *st, const rpl_gtid *list,
+                        uint32 count)
 {
   uint32 i;
 
-  for (i= 0; i < glev->count; ++i)
+  for (i= 0; i < count; ++i)
   {
-    uint32 gl_domain_id= glev->list[i].domain_id;
+    uint32 gl_domain_id= list[i].domain_id;
     const rpl_gtid *gtid= st->find(gl_domain_id);
     if (!gtid)
     {
@@ -1000,15 +1004,15 @@ contains_all_slave_gtid(slave_connection_state *st, Gtid_list_log_event *glev)
       */
       return false;
     }
-    if (gtid->server_id == glev->list[i].server_id &&
-        gtid->seq_no <= glev->list[i].seq_no)
+    if (gtid->server_id == list[i].server_id &&
+        gtid->seq_no <= list[i].seq_no)
     {
       /*
         The slave needs to start after gtid, but it is contained in an earlier
         binlog file. So we need to search back further, unless it was the very
         last gtid logged for the domain in earlier binlog files.
       */
-      if (gtid->seq_no < glev->list[i].seq_no)
+      if (gtid->seq_no < list[i].seq_no)
         return false;
 
       /*
@@ -1021,7 +1025,7 @@ contains_all_slave_gtid(slave_connection_state *st, Gtid_list_log_event *glev)
         beginning of this group, per the special case explained in comment at
         the start of this function. If not, then we need to search back further.
       */
-      if (i+1 < glev->count && gl_domain_id == glev->list[i+1].domain_id)
+      if (i+1 < count && gl_domain_id == list[i+1].domain_id)
         return false;
     }
   }
@@ -1272,13 +1276,19 @@ check_slave_start_position(binlog_send_info *info, const char **errormsg,
   corresponding entry in the slave state so we do not wrongly skip any events
   that might turn up if that domain becomes active again, vainly looking for
   the requested GTID that was already purged.
+
+  If the returned binlog file has a GTID index, then *out_pos may be set to
+  the offset of an entry in the index, and the above applies to the part of
+  the binlog file starting at that offset. Otherwise *out_pos is the start
+  of the binlog file.
 */
 static const char *
 gtid_find_binlog_file(slave_connection_state *state, char *out_name,
+                      my_off_t *out_pos,
                       slave_connection_state *until_gtid_state)
 {
   MEM_ROOT memroot;
-  binlog_file_entry *list;
+  binlog_file_entry *list, *newest;
   Gtid_list_log_event *glev= NULL;
   const char *errormsg= NULL;
   char buf[FN_REFLEN];
@@ -1290,11 +1300,14 @@ gtid_find_binlog_file(slave_connection_state *state, char *out_name,
     errormsg= "Out of memory while looking for GTID position in binlog";
     goto end;
   }
+  newest= list;
+  *out_pos= BIN_LOG_HEADER_SIZE;
 
   while (list)
   {
     File file;
     IO_CACHE cache;
+    my_off_t log_size;
 
     if (!list->next)
     {
@@ -1320,19 +1333,55 @@ gtid_find_binlog_file(slave_connection_state *state, char *out_name,
     if (unlikely((file= open_binlog(&cache, buf, &errormsg)) == (File)-1))
       goto end;
     errormsg= get_gtid_list_event(&cache, &glev);
+    log_size= my_b_filelength(&cache);
     end_io_cache(&cache);
     mysql_file_close(file, MYF(MY_WME));
     if (unlikely(errormsg))
       goto end;
 
-    if (!glev || contains_all_slave_gtid(state, glev))
+    if (!glev || contains_all_slave_gtid(state, glev->list, glev->count))
     {
       strmake(out_name, buf, FN_REFLEN);
 
       if (glev)
       {
+        const rpl_gtid *gl_list= glev->list;
+        uint32 gl_count= glev->count;
+        Binlog_gtid_index gtid_index;
         uint32 i;
 
+        /*
+          A binlog file that is no longer written to may have a GTID index.
+          Find the last entry in it that still contains all GTIDs requested
+          by the slave, and start from there as if it was the start of the
+          binlog file. START SLAVE UNTIL reads the binlog file from the start.
+        */
+        if (list != newest && !until_gtid_state)
+        {
+          if (gtid_index.read(buf, log_size))
+            statistic_increment(binlog_gtid_index_miss, &LOCK_status);
+          else
+          {
+            uint32 lo= 0, hi= gtid_index.count;
+            while (lo < hi)
+            {
+              uint32 mid= lo + (hi - lo) / 2;
+              if (contains_all_slave_gtid(state, gtid_index.get_list(mid),
+                                          gtid_index.get_list_len(mid)))
+                lo= mid + 1;
+              else
+                hi= mid;
+            }
+            if (lo > 0)
+            {
+              gl_list= gtid_index.get_list(lo - 1);
+              gl_count= gtid_index.get_list_len(lo - 1);
+              *out_pos= gtid_index.get_offset(lo - 1);
+            }
+            statistic_increment(binlog_gtid_index_hit, &LOCK_status);
+          }
+        }
+
         /*
           As a special case, we allow to start from binlog file N if the
           requested GTID is the last event (in the corresponding domain) in
@@ -1344,9 +1393,9 @@ gtid_find_binlog_file(slave_connection_state *state, char *out_name,
           from the UNTIL hash, to mark that such domains have already reached
           their UNTIL condition.
         */
-        for (i= 0; i < glev->count; ++i)
+        for (i= 0; i < gl_count; ++i)
         {
-          const rpl_gtid *gtid= state->find(glev->list[i].domain_id);
+          const rpl_gtid *gtid= state->find(gl_list[i].domain_id);
           if (!gtid)
           {
             /*
@@ -1359,8 +1408,8 @@ gtid_find_binlog_file(slave_connection_state *state, char *out_name,
               further GTIDs in the Gtid_list.
             */
             DBUG_ASSERT(0);
-          } else if (gtid->server_id == glev->list[i].server_id &&
-                     gtid->seq_no == glev->list[i].seq_no)
+          } else if (gtid->server_id == gl_list[i].server_id &&
+                     gtid->seq_no == gl_list[i].seq_no)
           {
             /*
               The slave requested to start from the very beginning of this
@@ -1371,9 +1420,9 @@ gtid_find_binlog_file(slave_connection_state *state, char *out_name,
           }
 
           if (until_gtid_state &&
-              (gtid= until_gtid_state->find(glev->list[i].domain_id)) &&
-              gtid->server_id == glev->list[i].server_id &&
-              gtid->seq_no <= glev->list[i].seq_no)
+              (gtid= until_gtid_state->find(gl_list[i].domain_id)) &&
+              gtid->server_id == gl_list[i].server_id &&
+              gtid->seq_no <= gl_list[i].seq_no)
           {
             /*
               We've already reached the stop position in UNTIL for this domain,
@@ -2166,16 +2215,17 @@ static int init_binlog_sender(binlog_send_info *info,
       info->error= error;
       return 1;
     }
+    /*
+      Start from the beginning of the binlog file, or from the offset found
+      in its GTID index.
+    */
     if ((info->errmsg= gtid_find_binlog_file(&info->gtid_state,
-                                             search_file_name,
+                                             search_file_name, pos,
                                              info->until_gtid_state)))
     {
       info->error= ER_MASTER_FATAL_ERROR_READING_BINLOG;
       return 1;
     }
-
-    /* start from beginning of binlog file */
-    *pos = 4;
   }
   else
   {
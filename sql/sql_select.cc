@@ -68,6 +68,7 @@
 #include "select_handler.h"
 #include "my_json_writer.h"
 #include "opt_trace.h"
+#include "opt_plan_cache.h"
 
 /*
   A key part number that means we're using a fulltext scan.
@@ -5538,7 +5539,7 @@ make_join_statistics(JOIN *join, List<TABLE_LIST> &tables_list,
     /* Find an optimal join order of the non-constant tables. */
     if (join->const_tables != join->table_count)
     {
-      if (choose_plan(join, all_table_map & ~join->const_table_map))
+      if (choose_plan(join, all_table_map & ~join->const_table_map, true))
         goto error;
 
 #ifdef HAVE_valgrind
@@ -8162,6 +8163,7 @@ static void choose_initial_table_order(JOIN *join)
   @param join         pointer to the structure providing all context info for
                       the query
   @param join_tables  set of the tables in the query
+  @param use_plan_cache  look up and store the join order in the plan cache
 
   @retval
     FALSE       ok
@@ -8170,7 +8172,7 @@ static void choose_initial_table_order(JOIN *join)
 */
 
 bool
-choose_plan(JOIN *join, table_map join_tables)
+choose_plan(JOIN *join, table_map join_tables, bool use_plan_cache)
 {
   uint search_depth= join->thd->variables.optimizer_search_depth;
   uint prune_level=  join->thd->variables.optimizer_prune_level;
@@ -8227,6 +8229,11 @@ choose_plan(JOIN *join, table_map join_tables)
   {
     optimize_straight_join(join, join_tables);
   }
+  else if (use_plan_cache && plan_cache_apply(join))
+  {
+    /* The join order was found in the plan cache, see opt_plan_cache.h */
+    optimize_straight_join(join, join_tables);
+  }
   else
   {
     DBUG_ASSERT(search_depth <= MAX_TABLES + 1);
@@ -8236,6 +8243,8 @@ choose_plan(JOIN *join, table_map join_tables)
     if (greedy_search(join, join_tables, search_depth, prune_level,
                       use_cond_selectivity))
       DBUG_RETURN(TRUE);
+    if (use_plan_cache)
+      plan_cache_store(join);
   }
 
   /* 
@@ -26251,6 +26260,8 @@ bool JOIN_TAB::save_explain_data(Explain_table_access *eta,
     Explain_rowid_filter *erf= new (thd->mem_root) Explain_rowid_filter;
     erf->quick= quick->get_explain(thd->mem_root);
     erf->selectivity= range_rowid_filter_info->selectivity;
+    erf->bloom_filter= range_rowid_filter_info->container_type ==
+                       BLOOM_FILTER_CONTAINER;
     erf->rows= quick->records;
     if (!(erf->tracker= new Rowid_filter_tracker(thd->lex->analyze_stmt)))
       return 1;
@@ -62,6 +62,7 @@
 #include "threadpool.h"
 #include "sql_repl.h"
 #include "opt_range.h"
+#include "opt_plan_cache.h"
 #include "rpl_parallel.h"
 #include "semisync_master.h"
 #include "semisync_slave.h"
@@ -2125,6 +2126,17 @@ static Sys_var_ulong Sys_slave_parallel_max_queued(
        GLOBAL_VAR(opt_slave_parallel_max_queued), CMD_LINE(REQUIRED_ARG),
        VALID_RANGE(0,2147483647), DEFAULT(131072), BLOCK_SIZE(1));
 
+static Sys_var_ulong Sys_slave_parallel_prefetch(
+       "slave_parallel_prefetch",
+       "Number of row events queued for a parallel replication worker "
+       "thread, starting with the one about to be applied, for which the "
+       "worker asks the storage engine to read ahead the primary key pages "
+       "of the rows, so that the page reads overlap. Only row events of the "
+       "current event group on tables it has already opened are read ahead. "
+       "0 disables the read-ahead.",
+       GLOBAL_VAR(opt_slave_parallel_prefetch), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0,1024), DEFAULT(4), BLOCK_SIZE(1));
+
 
 bool
 Sys_var_slave_parallel_mode::global_update(THD *thd, set_var *var)
@@ -2204,7 +2216,8 @@ Sys_var_slave_parallel_mode::global_value_ptr(THD *thd,
 
 /* The order here must match enum_slave_parallel_mode in mysqld.h. */
 static const char *slave_parallel_mode_names[] = {
-  "none", "minimal", "conservative", "optimistic", "aggressive", NULL
+  "none", "minimal", "conservative", "optimistic", "aggressive", "writeset",
+  NULL
 };
 export TYPELIB slave_parallel_mode_typelib = {
   array_elements(slave_parallel_mode_names)-1,
@@ -2221,6 +2234,9 @@ static Sys_var_slave_parallel_mode Sys_slave_parallel_mode(
        "with rollback and retry. \"conservative\" limits parallelism in an "
        "effort to avoid any conflicts. \"aggressive\" tries to maximise the "
        "parallelism, possibly at the cost of increased conflict rate. "
+       "\"writeset\" applies transactional DML in parallel like "
+       "\"aggressive\", but a transaction first waits for the commit of prior "
+       "transactions that changed the same rows. "
        "\"minimal\" only parallelizes the commit steps of transactions. "
        "\"none\" disables parallel apply completely.",
        GLOBAL_VAR(opt_slave_parallel_mode), NO_CMD_LINE,
@@ -2293,6 +2309,16 @@ static Sys_var_ulong Sys_binlog_commit_wait_usec(
        VALID_RANGE(0, ULONG_MAX), DEFAULT(100000), BLOCK_SIZE(1));
 
 
+static Sys_var_ulong Sys_binlog_gtid_index_span(
+       "binlog_gtid_index_span",
+       "Approximate number of bytes between the entries of the GTID index "
+       "that is written next to each binlog file. The index lets a slave "
+       "connecting with GTID start close to its position, rather than "
+       "reading the binlog file from the start. 0 disables the index.",
+       GLOBAL_VAR(opt_binlog_gtid_index_span), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, ULONG_MAX), DEFAULT(65536), BLOCK_SIZE(1));
+
+
 static bool fix_max_join_size(sys_var *self, THD *thd, enum_var_type type)
 {
   SV *sv= type == OPT_GLOBAL ? &global_system_variables : &thd->variables;
@@ -2345,6 +2371,14 @@ static Sys_var_ulong Sys_max_sort_length(
        SESSION_VAR(max_sort_length), CMD_LINE(REQUIRED_ARG),
        VALID_RANGE(4, 8192*1024L), DEFAULT(1024), BLOCK_SIZE(1));
 
+static Sys_var_ulong Sys_max_sort_threads(
+       "max_sort_threads",
+       "The maximum number of threads a sort operation may use to sort "
+       "the sort buffer. Each thread sorts a part of the buffer, then "
+       "the sorted parts are merged in parallel. 1 means no extra threads",
+       SESSION_VAR(max_sort_threads), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, 64), DEFAULT(1), BLOCK_SIZE(1));
+
 static Sys_var_ulong Sys_max_sp_recursion_depth(
        "max_sp_recursion_depth",
        "Maximum stored procedure recursion depth",
@@ -2559,6 +2593,21 @@ static Sys_var_ulong Sys_optimizer_search_depth(
        SESSION_VAR(optimizer_search_depth), CMD_LINE(REQUIRED_ARG),
        VALID_RANGE(0, MAX_TABLES+1), DEFAULT(MAX_TABLES+1), BLOCK_SIZE(1));
 
+static bool fix_plan_cache_size(sys_var *self, THD *thd, enum_var_type type)
+{
+  plan_cache_resize(plan_cache_size);
+  return false;
+}
+static Sys_var_ulong Sys_plan_cache_size(
+       "plan_cache_size",
+       "Maximum number of join orders of prepared statements that are "
+       "cached for reuse by all connections. If set to 0, the join order "
+       "is searched for on every execution.",
+       GLOBAL_VAR(plan_cache_size), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, 1024*1024), DEFAULT(0), BLOCK_SIZE(1),
+       NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(0),
+       ON_UPDATE(fix_plan_cache_size));
+
 /* this is used in the sigsegv handler */
 export const char *optimizer_switch_names[]=
 {
@@ -3790,6 +3839,23 @@ static Sys_var_mybool Sys_threadpool_dedicated_listener(
   GLOBAL_VAR(threadpool_dedicated_listener), CMD_LINE(OPT_ARG), DEFAULT(FALSE),
   NO_MUTEX_GUARD, NOT_IN_BINLOG
 );
+
+static Sys_var_mybool Sys_threadpool_batch_dispatch(
+  "thread_pool_batch_dispatch",
+  "If set to 1, listener wakes several idle workers at once for a batch "
+  "of network events, and a connection whose next command has already "
+  "arrived is queued without re-arming it in the poll descriptor",
+  GLOBAL_VAR(threadpool_batch_dispatch), CMD_LINE(OPT_ARG), DEFAULT(FALSE),
+  NO_MUTEX_GUARD, NOT_IN_BINLOG
+);
+
+static Sys_var_mybool Sys_threadpool_numa_bind(
+  "thread_pool_numa_bind",
+  "If set to 1, worker threads are bound to the CPUs of their group's "
+  "NUMA node. Takes effect for worker threads created after the change",
+  GLOBAL_VAR(threadpool_numa_bind), CMD_LINE(OPT_ARG), DEFAULT(FALSE),
+  NO_MUTEX_GUARD, NOT_IN_BINLOG
+);
 #endif /* HAVE_POOL_OF_THREADS */
 
 /**
@@ -42,6 +42,8 @@ uint threadpool_mode;
 uint threadpool_prio_kickup_timer;
 my_bool threadpool_exact_stats;
 my_bool threadpool_dedicated_listener;
+my_bool threadpool_batch_dispatch;
+my_bool threadpool_numa_bind;
 
 /* Stats */
 TP_STATISTICS tp_stats;
@@ -120,6 +120,9 @@ static void queue_put(thread_group_t *thread_group, native_event *ev, int cnt);
 static int  wake_thread(thread_group_t *thread_group,bool due_to_stall);
 static int  wake_or_create_thread(thread_group_t *thread_group, bool due_to_stall=false);
 static int  create_worker(thread_group_t *thread_group, bool due_to_stall);
+#ifndef HAVE_IOCP
+static int  wake_thief(thread_group_t *thread_group);
+#endif
 static void *worker_main(void *param);
 static void check_stall(thread_group_t *thread_group);
 static void set_next_timeout_check(ulonglong abstime);
@@ -233,6 +236,14 @@ static void *native_event_get_userdata(native_event *event)
   return event->data.ptr;
 }
 
+
+/* Check, without blocking, whether the client has sent more data. */
+static bool io_poll_has_data(TP_file_handle fd)
+{
+  char c;
+  return recv(fd, &c, 1, MSG_PEEK|MSG_DONTWAIT) > 0;
+}
+
 #elif defined(HAVE_KQUEUE)
 
 /* 
@@ -629,7 +640,14 @@ void check_stall(thread_group_t *thread_group)
   {
     thread_group->stalled= true;
     TP_INCREMENT_GROUP_COUNTER(thread_group,stalls);
-    wake_or_create_thread(thread_group,true);
+#ifndef HAVE_IOCP
+    /*
+      Rather than creating a new thread in the stalled group, let an idle
+      worker of another group steal the queued work.
+    */
+    if (wake_thread(thread_group, true) && wake_thief(thread_group))
+#endif
+      wake_or_create_thread(thread_group,true);
   }
   
   /* Reset queue event count */
@@ -663,6 +681,33 @@ static void stop_timer(pool_timer_t *timer)
 }
 
 
+/**
+  Wake idle workers for a batch of events put into the queue, in one pass.
+
+  At most one worker per event is woken, and no more than allowed by
+  thread_pool_oversubscribe are going to run at the same time.
+
+  @param thread_group
+  @param n_events  number of queued events
+  @param n_running number of threads about to run, that are not counted
+                   in active_thread_count yet
+  @return number of woken workers
+*/
+
+static int wake_workers(thread_group_t *thread_group, int n_events,
+                        int n_running)
+{
+  int room= 1 + (int) threadpool_oversubscribe -
+    thread_group->active_thread_count - n_running;
+  int n= std::min(n_events, room);
+  int woken= 0;
+
+  while (woken < n && !wake_thread(thread_group, false))
+    woken++;
+  return woken;
+}
+
+
 /**
   Poll for socket events and distribute them to worker threads
   In many case current thread will handle single event itself.
@@ -751,11 +796,15 @@ static TP_connection_generic * listener(worker_thread_t *current_thread,
     {
       /* Handle the first event. */
       retval= queue_get(thread_group);
+      /* In batch mode, hand out the rest of the events right away. */
+      if (threadpool_batch_dispatch)
+        wake_workers(thread_group, cnt - 1, 1);
       mysql_mutex_unlock(&thread_group->mutex);
       break;
     }
 
-    if(thread_group->active_thread_count==0)
+    int woken= threadpool_batch_dispatch ? wake_workers(thread_group, cnt, 0) : 0;
+    if(!woken && thread_group->active_thread_count==0)
     {
       /* We added some work items to queue, now wake a worker. */
       if(wake_thread(thread_group, false))
@@ -1092,6 +1141,137 @@ static bool too_many_threads(thread_group_t *thread_group)
 }
 
 
+#ifndef HAVE_IOCP
+/**
+  Check whether the queue of thread_group can be robbed, i.e nobody in
+  the group is going to serve it soon. This is the case when the group's
+  workers are busy executing queries, or the group is stalled.
+
+  thread_group->mutex must be held.
+*/
+
+static bool can_steal_from(thread_group_t *thread_group)
+{
+  return !thread_group->shutdown &&
+    (thread_group->active_thread_count > 0 || thread_group->stalled);
+}
+
+
+/**
+  Steal a queued connection from another thread group.
+
+  Called by a worker that found no work in its own group, before it goes
+  to sleep. This evens out skewed load, where connections are assigned to
+  groups by connection id and some groups get all the busy clients.
+
+  High priority connections of all groups are taken before low priority
+  ones. Within a priority, groups on the same NUMA node as the thief are
+  tried first. Mutexes of other groups are only try-locked, thus there is
+  no lock order between groups, and contended groups are skipped.
+
+  The connection migrates to the thief's group, so that wait_begin()/
+  wait_end() accounting and the next start_io() use the new group.
+
+  @param thread_group - current thread group, its mutex must be held
+  @return stolen connection, or NULL if there was nothing to steal
+*/
+
+static TP_connection_generic *steal_connection(thread_group_t *thread_group)
+{
+  uint count= group_count;
+  uint self= (uint) (thread_group - all_groups);
+
+  if (self >= count)
+    return NULL;
+
+  for (int prio= 0; prio < NQUEUES; prio++)
+  {
+    for (int same_node= 1; same_node >= 0; same_node--)
+    {
+      for (uint i= 1; i < count; i++)
+      {
+        thread_group_t *victim= &all_groups[(self + i) % count];
+        if ((victim->numa_node == thread_group->numa_node) != (bool) same_node)
+          continue;
+
+        /* Dirty read, to avoid locking groups with nothing to steal. */
+        if (victim->queues[prio].is_empty())
+          continue;
+
+        if (mysql_mutex_trylock(&victim->mutex))
+          continue;
+
+        TP_connection_generic *c= NULL;
+        if (can_steal_from(victim))
+          c= victim->queues[prio].pop_front();
+        if (c)
+        {
+          victim->queue_event_count++;
+          if (c->bound_to_poll_descriptor)
+          {
+            io_poll_disassociate_fd(victim->pollfd, c->fd);
+            c->bound_to_poll_descriptor= false;
+          }
+          victim->connection_count--;
+        }
+        mysql_mutex_unlock(&victim->mutex);
+
+        if (c)
+        {
+          c->thread_group= thread_group;
+          c->assigned_group_count= count;
+          thread_group->connection_count++;
+          return c;
+        }
+      }
+    }
+  }
+  return NULL;
+}
+
+
+/**
+  Wake an idle worker in another group, so that it steals work
+  from the stalled thread_group.
+
+  thread_group->mutex must be held.
+
+  @return 0 if a worker was woken, 1 if there was no idle worker
+*/
+
+static int wake_thief(thread_group_t *thread_group)
+{
+  uint count= group_count;
+  uint self= (uint) (thread_group - all_groups);
+
+  if (self >= count)
+    return 1;
+
+  for (int same_node= 1; same_node >= 0; same_node--)
+  {
+    for (uint i= 1; i < count; i++)
+    {
+      thread_group_t *group= &all_groups[(self + i) % count];
+      if ((group->numa_node == thread_group->numa_node) != (bool) same_node)
+        continue;
+
+      /* Dirty read, to avoid locking groups without idle workers. */
+      if (group->waiting_threads.is_empty())
+        continue;
+
+      if (mysql_mutex_trylock(&group->mutex))
+        continue;
+      int ret= group->shutdown ? 1 : wake_thread(group, true);
+      mysql_mutex_unlock(&group->mutex);
+      if (!ret)
+        return 0;
+    }
+  }
+  return 1;
+}
+#endif
+
+
 /**
   Retrieve a connection with pending event.
   
@@ -1174,6 +1354,16 @@ TP_connection_generic *get_event(worker_thread_t *current_thread,
         connection= queue_get(thread_group);
         break;
       }
+
+#ifndef HAVE_IOCP
+      /* Nothing to do in own group, help out a busy one. */
+      connection= steal_connection(thread_group);
+      if (connection)
+      {
+        TP_INCREMENT_GROUP_COUNTER(thread_group, steals);
+        break;
+      }
+#endif
     }
 
 
@@ -1362,6 +1552,7 @@ TP_connection_generic::TP_connection_generic(CONNECT *c):
     &all_groups[c->thread_id%group_count];
 
   thread_group=group;
+  assigned_group_count= group_count;
 
   mysql_mutex_lock(&group->mutex);
   group->connection_count++;
@@ -1446,16 +1637,41 @@ int TP_connection_generic::start_io()
     connection should need to migrate  to another group, this ensures
     to ensure equal load between groups.
 
-    So we recalculate in which group the connection should be, based
-    on thread_id and current group count, and migrate if necessary.
+    So if group count has changed since the group was assigned, we
+    recalculate in which group the connection should be, based on
+    thread_id and current group count, and migrate if necessary.
+    Connections that were moved by steal_connection() stay in the
+    new group otherwise.
   */ 
-  thread_group_t *group = 
-    &all_groups[thd->thread_id%group_count];
+  uint count= group_count;
+  if (assigned_group_count != count)
+  {
+    thread_group_t *group = 
+      &all_groups[thd->thread_id%count];
+
+    if (group != thread_group)
+    {
+      if (change_group(this, thread_group, group))
+        return -1;
+    }
+    assigned_group_count= count;
+  }
+#endif
 
-  if (group != thread_group)
+#ifdef __linux__
+  /*
+    In batch dispatch mode, a connection whose client has already sent
+    the next command is not re-armed in the poll descriptor, but put
+    into the queue directly. This saves epoll_ctl() and the trip through
+    the listener. The connection is re-armed once it becomes idle.
+  */
+  if (threadpool_batch_dispatch && bound_to_poll_descriptor &&
+      io_poll_has_data(fd))
   {
-    if (change_group(this, thread_group, group))
-      return -1;
+    mysql_mutex_lock(&thread_group->mutex);
+    queue_put(thread_group, this);
+    mysql_mutex_unlock(&thread_group->mutex);
+    return 0;
   }
 #endif
 
@@ -1473,6 +1689,112 @@ int TP_connection_generic::start_io()
 
 
 
+#ifdef __linux__
+/*
+  NUMA aware placement of thread groups.
+
+  Groups are spread round-robin over NUMA nodes. With
+  thread_pool_numa_bind=ON, worker threads of a group are bound to the
+  CPUs of the group's node, so that a group's threads share caches and
+  allocate memory locally. Topology is read from sysfs, the pool does
+  not depend on libnuma.
+*/
+#define TP_MAX_NUMA_NODES 64
+static uint numa_node_count;
+static cpu_set_t numa_node_cpus[TP_MAX_NUMA_NODES];
+
+/**
+  Parse a sysfs CPU list, like "0-3,8-11"
+
+  @return false on success, true on parse error
+*/
+
+static bool parse_cpu_list(const char *str, cpu_set_t *cpus)
+{
+  CPU_ZERO(cpus);
+  while (*str && *str != '\n')
+  {
+    char *end;
+    ulong first= strtoul(str, &end, 10);
+    ulong last= first;
+    if (end == str)
+      return true;
+    if (*end == '-')
+    {
+      str= end + 1;
+      last= strtoul(str, &end, 10);
+      if (end == str)
+        return true;
+    }
+    for (ulong cpu= first; cpu <= last && cpu < CPU_SETSIZE; cpu++)
+      CPU_SET(cpu, cpus);
+    str= end;
+    if (*str == ',')
+      str++;
+  }
+  return false;
+}
+
+
+/**
+  Find NUMA nodes that have CPUs the server is allowed to run on.
+  Placement is only done if there is more than one such node.
+*/
+
+static void numa_init()
+{
+  cpu_set_t allowed;
+
+  numa_node_count= 0;
+  if (sched_getaffinity(0, sizeof(allowed), &allowed))
+    return;
+
+  for (uint node= 0; node < TP_MAX_NUMA_NODES; node++)
+  {
+    char path[FN_REFLEN];
+    char buf[4096];
+    cpu_set_t *cpus= &numa_node_cpus[numa_node_count];
+
+    my_snprintf(path, sizeof(path),
+                "/sys/devices/system/node/node%u/cpulist", node);
+    File fd= my_open(path, O_RDONLY, MYF(0));
+    if (fd < 0)
+      continue;
+    size_t len= my_read(fd, (uchar *) buf, sizeof(buf) - 1, MYF(0));
+    my_close(fd, MYF(0));
+    if (len == MY_FILE_ERROR)
+      continue;
+    buf[len]= 0;
+
+    if (parse_cpu_list(buf, cpus))
+      continue;
+    /* Skip memory-only nodes, and nodes outside of our cpuset */
+    CPU_AND(cpus, cpus, &allowed);
+    if (CPU_COUNT(cpus))
+      numa_node_count++;
+  }
+
+  if (numa_node_count < 2)
+    numa_node_count= 0;
+}
+
+
+/**
+  Bind the current worker thread to the CPUs of its group's NUMA node.
+  With fewer groups than nodes, some nodes would get no workers at all,
+  so the worker is not bound then.
+*/
+
+static void numa_bind_worker(thread_group_t *thread_group)
+{
+  if (threadpool_numa_bind && numa_node_count &&
+      group_count >= numa_node_count)
+    pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t),
+                           &numa_node_cpus[thread_group->numa_node]);
+}
+#endif
+
+
 /**
   Worker thread's main
 */
@@ -1492,6 +1814,9 @@ static void *worker_main(void *param)
   mysql_cond_init(key_worker_cond, &this_thread.cond, NULL);
   this_thread.thread_group= thread_group;
   this_thread.event_count=0;
+#ifdef __linux__
+  numa_bind_worker(thread_group);
+#endif
 
   /* Run event loop */
   for(;;)
@@ -1541,9 +1866,16 @@ int TP_pool_generic::init()
   }
   scheduler_init();
   threadpool_started= true;
+#ifdef __linux__
+  numa_init();
+#endif
   for (uint i= 0; i < threadpool_max_size; i++)
   {
     thread_group_init(&all_groups[i], get_connection_attrib());  
+#ifdef __linux__
+    if (numa_node_count)
+      all_groups[i].numa_node= i % numa_node_count;
+#endif
   }
   set_pool_size(threadpool_size);
   if(group_count == 0)
@@ -86,6 +86,8 @@ struct TP_connection_generic :public TP_connection
   TP_connection_generic** prev_in_queue;
   ulonglong abs_wait_timeout;
   ulonglong enqueue_time;
+  /* Number of groups in the pool when thread_group was assigned */
+  uint assigned_group_count;
   TP_file_handle fd;
   bool bound_to_poll_descriptor;
   int waiting;
@@ -120,6 +122,7 @@ struct thread_group_counters_t
   ulonglong dequeues_by_listener;
   ulonglong polls_by_listener;
   ulonglong polls_by_worker;
+  ulonglong steals;
 };
 
 struct MY_ALIGNED(CPU_LEVEL1_DCACHE_LINESIZE) thread_group_t
@@ -138,6 +141,8 @@ struct MY_ALIGNED(CPU_LEVEL1_DCACHE_LINESIZE) thread_group_t
   int queue_event_count;
   ulonglong last_thread_creation_time;
   int  shutdown_pipe[2];
+  /* NUMA node the group's worker threads run on */
+  uint numa_node;
   bool shutdown;
   bool stalled;
   thread_group_counters_t counters;
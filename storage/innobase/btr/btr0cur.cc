@@ -6718,6 +6718,77 @@ btr_estimate_n_rows_in_range(
 		index, tuple1, mode1, tuple2, mode2, 1);
 }
 
+/** Read ahead the leaf page of an index tree on which a search for a
+tuple would end up, without waiting for the read to complete.
+The non-leaf pages are accessed as in a BTR_SEARCH_LEAF search; they
+are normally in the buffer pool.
+@param[in]	index	B-tree index
+@param[in]	tuple	search tuple */
+void btr_cur_prefetch_leaf(dict_index_t* index, const dtuple_t* tuple)
+{
+	mtr_t		mtr;
+	mem_heap_t*	heap		= NULL;
+	offset_t	offsets_[REC_OFFS_NORMAL_SIZE];
+	offset_t*	offsets		= offsets_;
+	ulint		page_no		= FIL_NULL;
+	ulint		zip_size	= 0;
+
+	rec_offs_init(offsets_);
+
+	ut_ad(!index->is_spatial());
+	ut_ad(!dict_index_is_ibuf(index));
+
+	mtr.start();
+	mtr_s_lock_index(index, &mtr);
+
+	buf_block_t*	block = btr_root_block_get(index, RW_S_LATCH, &mtr);
+
+	while (block && !page_is_leaf(block->frame)
+	       && !page_is_empty(block->frame)) {
+		page_cur_t	cursor;
+		ulint		up_match = 0;
+		ulint		low_match = 0;
+
+		page_cur_search_with_match(block, index, tuple, PAGE_CUR_LE,
+					   &up_match, &low_match, &cursor,
+					   NULL);
+
+		const rec_t*	node_ptr = page_cur_get_rec(&cursor);
+
+		if (!page_rec_is_user_rec(node_ptr)) {
+			break;
+		}
+
+		offsets = rec_get_offsets(node_ptr, index, offsets, false,
+					  ULINT_UNDEFINED, &heap);
+		ulint	child = btr_node_ptr_get_child_page_no(node_ptr,
+							       offsets);
+
+		if (btr_page_get_level(block->frame) == 1) {
+			page_no = child;
+			zip_size = block->zip_size();
+			break;
+		}
+
+		buf_block_t*	child_block = btr_block_get(
+			*index, child, RW_S_LATCH, false, &mtr);
+		mtr.memo_release(block, MTR_MEMO_PAGE_S_FIX);
+		block = child_block;
+	}
+
+	mtr.commit();
+
+	if (UNIV_LIKELY_NULL(heap)) {
+		mem_heap_free(heap);
+	}
+
+	if (page_no != FIL_NULL) {
+		buf_read_page_background(
+			page_id_t(index->table->space_id, page_no),
+			zip_size, false);
+	}
+}
+
 /*******************************************************************//**
 Record the number of non_null key values in a given index for
 each n-column prefix of the index where 1 <= n <= dict_index_get_n_unique(index).
@@ -77,6 +77,21 @@ UNIV_INTERN byte		btr_sea_pad2[CACHE_LINE_SIZE];
 /** The adaptive hash index */
 btr_search_sys_t*	btr_search_sys;
 
+/** Number of threads that are searching the adaptive hash index without
+holding btr_search_latches, see btr_search_guess_unlatched() */
+static ib_counter_t<lint>	btr_search_unlatched_readers;
+
+/** Number of times the hash index was suspended on an index,
+because too few lookups succeeded */
+Atomic_counter<ulint>		btr_search_n_index_disabled;
+/** Number of searches without btr_search_latches that had to be
+repeated while holding the latch */
+Atomic_counter<ulint>		btr_search_n_unlatched_retries;
+
+/** btr_search_disable() yields this many times while waiting for
+the searches without btr_search_latches, before it starts sleeping */
+#define BTR_SEARCH_DISABLE_SPIN_ROUNDS	100U
+
 /** If the number of records on the page divided by this parameter
 would have been successfully accessed using a hash index, the index
 is then built on the page, assuming the global limit has been reached */
@@ -86,6 +101,18 @@ is then built on the page, assuming the global limit has been reached */
 before hash index building is started */
 #define BTR_SEARCH_BUILD_LIMIT		100U
 
+/** The hit ratio of the hash index on an index is evaluated after
+this many lookups */
+#define BTR_SEARCH_HIT_RATIO_LOOKUPS	1000U
+
+/** If less than one in this many lookups succeeds, the hash index is
+not used on the index for BTR_SEARCH_DISABLED_SEARCHES searches */
+#define BTR_SEARCH_MIN_HIT_RATIO	4U
+
+/** Number of searches after which the hash index is tried again
+on an index where it did not pay off */
+#define BTR_SEARCH_DISABLED_SEARCHES	100000U
+
 /** Compute a hash value of a record in a page.
 @param[in]	rec		index record
 @param[in]	offsets		return value of rec_get_offsets()
@@ -396,10 +423,27 @@ void btr_search_disable(bool need_mutex)
 	/* Set all block->index = NULL. */
 	buf_pool_clear_hash_index();
 
+	/* Wait for the searches that are not holding btr_search_latches
+	and did not notice !btr_search_enabled. After this, no thread can
+	be looking at the hash nodes that we are about to free. */
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	/* A registered search only looks up the hash table and tries to
+	latch a page without waiting, so this should be short. A search
+	may still be descheduled, so do not keep burning CPU for it. */
+	for (ulint round = 0; btr_search_unlatched_readers; round++) {
+		if (round < BTR_SEARCH_DISABLE_SPIN_ROUNDS) {
+			os_thread_yield();
+		} else {
+			os_thread_sleep(1000);
+		}
+	}
+
 	/* Clear the adaptive hash index. */
 	for (ulint i = 0; i < btr_ahi_parts; ++i) {
 		hash_table_clear(btr_search_sys->hash_tables[i]);
 		mem_heap_empty(btr_search_sys->hash_tables[i]->heap);
+		btr_search_sys->hash_tables[i]->free_nodes = NULL;
 	}
 
 	btr_search_x_unlock_all();
@@ -827,12 +871,44 @@ btr_search_check_guess(
 	return(success);
 }
 
+/** Account for a lookup in the hash index of an index, and stop using
+the hash index on the index for a while if too few lookups succeed.
+NOTE that info is NOT protected by any semaphore, to save CPU time!
+@param[in,out]	info	search info
+@param[in]	success	whether the lookup succeeded */
+static void btr_search_update_hit_ratio(btr_search_t* info, bool success)
+{
+	info->n_lookup_hits += success;
+
+	if (++info->n_lookups < BTR_SEARCH_HIT_RATIO_LOOKUPS) {
+		return;
+	}
+
+	if (info->n_lookup_hits * BTR_SEARCH_MIN_HIT_RATIO
+	    < info->n_lookups) {
+		/* The failed lookups cost more than the successful
+		ones save. The hash index will be dropped from the
+		pages of the index as they are modified, see
+		btr_search_drop_if_disabled(). */
+		if (!info->n_disabled) {
+			btr_search_n_index_disabled++;
+		}
+		info->n_disabled = BTR_SEARCH_DISABLED_SEARCHES;
+		info->n_hash_potential = 0;
+	}
+
+	info->n_lookups = 0;
+	info->n_lookup_hits = 0;
+}
+
 static
 void
 btr_search_failure(btr_search_t* info, btr_cur_t* cursor)
 {
 	cursor->flag = BTR_CUR_HASH_FAIL;
 
+	btr_search_update_hit_ratio(info, false);
+
 #ifdef UNIV_SEARCH_PERF_STAT
 	++info->n_hash_fail;
 
@@ -844,6 +920,183 @@ btr_search_failure(btr_search_t* info, btr_cur_t* cursor)
 	info->last_hash_succ = FALSE;
 }
 
+/** Buffer-fix and latch the page of a record that was found in the
+adaptive hash index.
+@param[in,out]	block		buffer block of the record
+@param[in]	latch_mode	BTR_SEARCH_LEAF or BTR_MODIFY_LEAF
+@param[out]	fix_type	how the page was latched
+@return whether the page was latched */
+static
+bool
+btr_search_fix_block(
+	buf_block_t*	block,
+	ulint		latch_mode,
+	mtr_memo_type_t* fix_type)
+{
+	mutex_enter(&block->mutex);
+
+	if (buf_block_get_state(block) != BUF_BLOCK_FILE_PAGE) {
+		/* Another thread is just freeing the block from the
+		LRU list of the buffer pool (BUF_BLOCK_REMOVE_HASH), or,
+		if we are not holding the adaptive hash index latch, the
+		block may already have been freed: do not try to access
+		this page. */
+		mutex_exit(&block->mutex);
+		return(false);
+	}
+
+	buf_page_set_accessed(&block->page);
+	buf_block_buf_fix_inc(block, __FILE__, __LINE__);
+	mutex_exit(&block->mutex);
+
+	if (latch_mode == BTR_SEARCH_LEAF) {
+		if (rw_lock_s_lock_nowait(&block->lock, __FILE__, __LINE__)) {
+			*fix_type = MTR_MEMO_PAGE_S_FIX;
+			return(true);
+		}
+	} else if (rw_lock_x_lock_func_nowait_inline(
+			   &block->lock, __FILE__, __LINE__)) {
+		*fix_type = MTR_MEMO_PAGE_X_FIX;
+		return(true);
+	}
+
+	buf_block_buf_fix_dec(block);
+	return(false);
+}
+
+/** Outcome of btr_search_guess_unlatched() */
+enum btr_search_unlatched_t {
+	/** The record was found, and its page was latched */
+	BTR_SEARCH_UNLATCHED_FOUND,
+	/** The fold value is not in the adaptive hash index */
+	BTR_SEARCH_UNLATCHED_NOT_FOUND,
+	/** The result is not reliable; the search must be repeated
+	while holding the adaptive hash index latch */
+	BTR_SEARCH_UNLATCHED_RETRY
+};
+
+/** Look up the adaptive hash index without acquiring btr_search_latches,
+and latch the page of the found record.
+
+The lookup is validated with the modification count of the hash table
+partition, which ha_insert_for_fold(), ha_delete_hash_node() and the like
+increment while holding the latch in exclusive mode. If the count did
+not change until the page was buffer-fixed, the hash node still pointed
+to the record, and the page cannot have been evicted or reused meanwhile,
+because btr_search_drop_page_hash_index() would have removed the node.
+Deleted hash nodes are only reused for other nodes, and the hash node
+memory is only freed by btr_search_disable(), which waits for us.
+
+@param[in]	index		index
+@param[in]	fold		folded value of the search tuple
+@param[in]	latch_mode	BTR_SEARCH_LEAF or BTR_MODIFY_LEAF
+@param[out]	block		buffer block of the found record
+@param[out]	rec		found record
+@param[in,out]	mtr		mini-transaction
+@return	outcome of the search */
+static
+btr_search_unlatched_t
+btr_search_guess_unlatched(
+	const dict_index_t*	index,
+	ulint			fold,
+	ulint			latch_mode,
+	buf_block_t**		block,
+	const rec_t**		rec,
+	mtr_t*			mtr)
+{
+	btr_search_unlatched_t	ret = BTR_SEARCH_UNLATCHED_RETRY;
+	const size_t		slot = get_rnd_value();
+
+	/* Register the search, so that btr_search_disable() will wait
+	for it to finish before freeing the hash tables. Either we
+	will notice !btr_search_enabled, or btr_search_disable() will
+	notice us. */
+	btr_search_unlatched_readers.add(slot, 1);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	if (btr_search_enabled) {
+		hash_table_t*	table = btr_get_search_table(index);
+		ulint		n_modified;
+		mtr_memo_type_t	fix_type;
+
+		*rec = ha_search_and_get_data_unlatched(table, fold,
+							&n_modified);
+
+		if (!ha_search_unlatched_valid(table, n_modified)) {
+		} else if (*rec == NULL) {
+			ret = BTR_SEARCH_UNLATCHED_NOT_FOUND;
+		} else if (btr_search_fix_block(
+				   *block = buf_block_from_ahi(*rec),
+				   latch_mode, &fix_type)) {
+			if (ha_search_unlatched_valid(table, n_modified)) {
+				ut_ad(!(*block)->page.file_page_was_freed);
+				mtr->memo_push(*block, fix_type);
+				buf_pool_from_block(*block)
+					->stat.n_page_gets++;
+				ret = BTR_SEARCH_UNLATCHED_FOUND;
+			} else {
+				rw_lock_t*	lock = &(*block)->lock;
+
+				if (fix_type == MTR_MEMO_PAGE_S_FIX) {
+					rw_lock_s_unlock(lock);
+				} else {
+					rw_lock_x_unlock(lock);
+				}
+
+				buf_block_buf_fix_dec(*block);
+			}
+		}
+	}
+
+	std::atomic_thread_fence(std::memory_order_release);
+	btr_search_unlatched_readers.add(slot, -1);
+
+	return(ret);
+}
+
+/** Look up the adaptive hash index while holding the latch of the
+hash table partition, and latch the page of the found record.
+@param[in]	index		index
+@param[in]	fold		folded value of the search tuple
+@param[in]	latch_mode	BTR_SEARCH_LEAF or BTR_MODIFY_LEAF
+@param[out]	rec		found record
+@param[in,out]	mtr		mini-transaction
+@return buffer block of the found record
+@retval NULL if the record was not found or its page was not latched */
+static
+buf_block_t*
+btr_search_guess_latched(
+	const dict_index_t*	index,
+	ulint			fold,
+	ulint			latch_mode,
+	const rec_t**		rec,
+	mtr_t*			mtr)
+{
+	rw_lock_t*	ahi_latch = btr_get_search_latch(index);
+	buf_block_t*	block = NULL;
+	mtr_memo_type_t	fix_type;
+
+	rw_lock_s_lock(ahi_latch);
+
+	if (btr_search_enabled
+	    && (*rec = ha_search_and_get_data(btr_get_search_table(index),
+					      fold)) != NULL) {
+		block = buf_block_from_ahi(*rec);
+
+		if (btr_search_fix_block(block, latch_mode, &fix_type)) {
+			ut_ad(!block->page.file_page_was_freed);
+			mtr->memo_push(block, fix_type);
+			buf_pool_from_block(block)->stat.n_page_gets++;
+		} else {
+			block = NULL;
+		}
+	}
+
+	rw_lock_s_unlock(ahi_latch);
+
+	return(block);
+}
+
 /** Tries to guess the right search position based on the hash search info
 of the index. Note that if mode is PAGE_CUR_LE, which is used in inserts,
 and the function returns TRUE, then cursor->up_match and cursor->low_match
@@ -898,7 +1151,7 @@ btr_search_guess_on_hash(
 	/* Note that, for efficiency, the struct info may not be protected by
 	any latch here! */
 
-	if (info->n_hash_potential == 0) {
+	if (info->n_hash_potential == 0 || info->n_disabled) {
 
 		return(FALSE);
 	}
@@ -921,79 +1174,44 @@ btr_search_guess_on_hash(
 	cursor->fold = fold;
 	cursor->flag = BTR_CUR_HASH;
 
-	rw_lock_t* use_latch = ahi_latch ? NULL : btr_get_search_latch(index);
-
-	if (use_latch) {
-		rw_lock_s_lock(use_latch);
+	buf_block_t*	block;
 
-		if (!btr_search_enabled) {
-			goto fail;
-		}
-	} else {
+	if (ahi_latch) {
 		ut_ad(btr_search_enabled);
 		ut_ad(rw_lock_own(ahi_latch, RW_LOCK_S));
-	}
-
-	rec = (rec_t*) ha_search_and_get_data(
-		btr_get_search_table(index), fold);
-
-	if (rec == NULL) {
-		if (use_latch) {
-fail:
-			rw_lock_s_unlock(use_latch);
-		}
-
-		btr_search_failure(info, cursor);
 
-		return(FALSE);
-	}
-
-	buf_block_t* block = buf_block_from_ahi(rec);
-	buf_pool_t* buf_pool = buf_pool_from_block(block);
-
-	if (use_latch) {
-		mutex_enter(&block->mutex);
-
-		if (buf_block_get_state(block) == BUF_BLOCK_REMOVE_HASH) {
-			/* Another thread is just freeing the block
-			from the LRU list of the buffer pool: do not
-			try to access this page. */
-			mutex_exit(&block->mutex);
-			goto fail;
+		rec = ha_search_and_get_data(btr_get_search_table(index),
+					     fold);
+		if (rec == NULL) {
+			btr_search_failure(info, cursor);
+			return(FALSE);
 		}
 
-		ut_ad(buf_block_get_state(block) == BUF_BLOCK_FILE_PAGE);
-		ut_ad(!block->page.file_page_was_freed);
-		buf_page_set_accessed(&block->page);
-		buf_block_buf_fix_inc(block, __FILE__, __LINE__);
-		mutex_exit(&block->mutex);
-
-		buf_page_make_young_if_needed(buf_pool, &block->page);
-		mtr_memo_type_t	fix_type;
-		if (latch_mode == BTR_SEARCH_LEAF) {
-			if (!rw_lock_s_lock_nowait(&block->lock,
-						   __FILE__, __LINE__)) {
-got_no_latch:
-				buf_block_buf_fix_dec(block);
-				goto fail;
-			}
-			fix_type = MTR_MEMO_PAGE_S_FIX;
-		} else {
-			if (!rw_lock_x_lock_func_nowait_inline(
-				    &block->lock, __FILE__, __LINE__)) {
-				goto got_no_latch;
+		block = buf_block_from_ahi(rec);
+	} else {
+		switch (btr_search_guess_unlatched(index, fold, latch_mode,
+						   &block, &rec, mtr)) {
+		case BTR_SEARCH_UNLATCHED_FOUND:
+			break;
+		case BTR_SEARCH_UNLATCHED_NOT_FOUND:
+			btr_search_failure(info, cursor);
+			return(FALSE);
+		case BTR_SEARCH_UNLATCHED_RETRY:
+			btr_search_n_unlatched_retries++;
+			block = btr_search_guess_latched(index, fold,
+							 latch_mode, &rec,
+							 mtr);
+			if (block == NULL) {
+				btr_search_failure(info, cursor);
+				return(FALSE);
 			}
-			fix_type = MTR_MEMO_PAGE_X_FIX;
 		}
-		mtr->memo_push(block, fix_type);
-
-		buf_pool->stat.n_page_gets++;
-
-		rw_lock_s_unlock(use_latch);
 
 		buf_block_dbg_add_level(block, SYNC_TREE_NODE_FROM_HASH);
 	}
 
+	buf_pool_t*	buf_pool = buf_pool_from_block(block);
+
 	if (buf_block_get_state(block) != BUF_BLOCK_FILE_PAGE) {
 
 		ut_ad(buf_block_get_state(block) == BUF_BLOCK_REMOVE_HASH);
@@ -1072,6 +1290,7 @@ btr_search_guess_on_hash(
 	meanwhile! Thus it might not be a bug. */
 #endif
 	info->last_hash_succ = TRUE;
+	btr_search_update_hit_ratio(info, true);
 
 #ifdef UNIV_SEARCH_PERF_STAT
 	btr_search_n_succ++;
@@ -1592,6 +1811,23 @@ btr_search_info_update_slow(btr_search_t* info, btr_cur_t* cursor)
 	}
 }
 
+/** Drop the hash index of a page that is about to be modified, if the
+hash index is not being used on the index, instead of maintaining it.
+@param[in,out]	block	x-latched index page
+@param[in]	index	index of the page in the hash index
+@return whether the hash index of the page was dropped */
+static
+bool
+btr_search_drop_if_disabled(buf_block_t* block, const dict_index_t* index)
+{
+	if (!index->search_info->n_disabled) {
+		return(false);
+	}
+
+	btr_search_drop_page_hash_index(block);
+	return(true);
+}
+
 /** Move or delete hash entries for moved records, usually in a page split.
 If new_block is already hashed, then any hash index for block is dropped.
 If new_block is not hashed, and block is hashed, then a new hash index is
@@ -1626,7 +1862,7 @@ btr_search_move_or_delete_hash_entries(
 		return;
 	}
 
-	if (!index) {
+	if (!index || btr_search_drop_if_disabled(block, index)) {
 		return;
 	}
 
@@ -1687,7 +1923,7 @@ void btr_search_update_hash_on_delete(btr_cur_t* cursor)
 	assert_block_ahi_valid(block);
 	index = block->index;
 
-	if (!index) {
+	if (!index || btr_search_drop_if_disabled(block, index)) {
 
 		return;
 	}
@@ -1760,7 +1996,7 @@ btr_search_update_hash_node_on_insert(btr_cur_t* cursor, rw_lock_t* ahi_latch)
 
 	index = block->index;
 
-	if (!index) {
+	if (!index || btr_search_drop_if_disabled(block, index)) {
 
 		return;
 	}
@@ -1844,7 +2080,7 @@ btr_search_update_hash_on_insert(btr_cur_t* cursor, rw_lock_t* ahi_latch)
 
 	index = block->index;
 
-	if (!index) {
+	if (!index || btr_search_drop_if_disabled(block, index)) {
 
 		return;
 	}
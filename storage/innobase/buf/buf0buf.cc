@@ -1894,6 +1894,19 @@ buf_pool_init_instance(
 		buf_pool->old_size = buf_pool->curr_size;
 		buf_pool->n_chunks_new = buf_pool->n_chunks;
 
+		if (!srv_n_page_hash_locks) {
+			/* Scale the number of page_hash latches with
+			the size of the buffer pool instance, so that
+			lookups of different pages seldom contend on
+			the same latch. */
+			srv_n_page_hash_locks = static_cast<ulong>(
+				ut_min<ulint>(
+					MAX_PAGE_HASH_LOCKS,
+					ut_max<ulint>(
+						16, buf_pool->curr_size
+						/ BUF_PAGE_HASH_PAGES_PER_LOCK)));
+		}
+
 		/* Number of locks protecting page_hash must be a
 		power of two */
 		srv_n_page_hash_locks = static_cast<ulong>(
@@ -2030,6 +2043,26 @@ buf_pool_free_instance(
 	buf_pool->allocator.~ut_allocator();
 }
 
+/** Register the memory of all buffer pool chunks as IO buffers, so that
+the IO of page frames can avoid mapping the memory on every request. */
+static void buf_pool_register_io_buffers()
+{
+	std::vector<void*>	bufs;
+	std::vector<size_t>	lens;
+
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		const buf_pool_t*	buf_pool = buf_pool_from_array(i);
+		const buf_chunk_t*	chunk = buf_pool->chunks;
+
+		for (ulint n = buf_pool->n_chunks; n--; chunk++) {
+			bufs.push_back(chunk->mem);
+			lens.push_back(chunk->mem_size());
+		}
+	}
+
+	os_aio_register_buffers(bufs.data(), lens.data(), bufs.size());
+}
+
 /********************************************************************//**
 Creates the buffer pool.
 @return DB_SUCCESS if success, DB_ERROR if not enough memory or error */
@@ -2076,6 +2109,8 @@ buf_pool_init(
 
 	btr_search_sys_create(buf_pool_get_curr_size() / sizeof(void*) / 64);
 
+	buf_pool_register_io_buffers();
+
 	return(DB_SUCCESS);
 }
 
@@ -2831,6 +2866,10 @@ buf_pool_resize()
 		return;
 	}
 
+	/* Chunks may be freed below. Fall back to unregistered
+	IO buffers until the resizing is complete. */
+	os_aio_unregister_buffers();
+
 	/* Indicate critical path */
 	buf_pool_resizing = true;
 
@@ -3081,6 +3120,8 @@ buf_pool_resize()
 			" dictionary.";
 	}
 
+	buf_pool_register_io_buffers();
+
 	/* normalize ibuf.max_size */
 	ibuf_max_size_update(srv_change_buffer_max_size);
 
@@ -4000,11 +4041,11 @@ buf_block_from_ahi(const byte* ptr)
 	/* The function buf_chunk_init() invokes buf_block_init() so that
 	block[n].frame == block->frame + n * srv_page_size.  Check it. */
 	ut_ad(block->frame == page_align(ptr));
-	/* Read the state of the block without holding a mutex.
-	A state transition from BUF_BLOCK_FILE_PAGE to
-	BUF_BLOCK_REMOVE_HASH is possible during this execution. */
-	ut_d(const buf_page_state state = buf_block_get_state(block));
-	ut_ad(state == BUF_BLOCK_FILE_PAGE || state == BUF_BLOCK_REMOVE_HASH);
+	/* The state of the block is not checked here, because
+	btr_search_guess_on_hash() may invoke this without holding
+	the adaptive hash index latch, and the page may have been
+	evicted meanwhile. The caller will check the state while
+	holding block->mutex. */
 	return(block);
 }
 #endif /* BTR_CUR_HASH_ADAPT */
@@ -42,6 +42,13 @@ ibool	buf_dblwr_being_created = FALSE;
 
 #define TRX_SYS_DOUBLEWRITE_BLOCKS 2
 
+/** @return whether a doublewrite buffer slot is used for single page flushes
+@param[in]	i	slot in write_buf and buf_block_arr */
+static bool buf_dblwr_is_single_page_slot(ulint i)
+{
+	return i % TRX_SYS_DOUBLEWRITE_BLOCK_SIZE >= buf_dblwr->seg_size;
+}
+
 /****************************************************************//**
 Determines if a page number is located inside the doublewrite buffer.
 @return TRUE if the location is inside the two blocks of the
@@ -114,15 +121,32 @@ static void buf_dblwr_init(const byte *doublewrite)
 
 	buf_dblwr->b_event = os_event_create("dblwr_batch_event");
 	buf_dblwr->s_event = os_event_create("dblwr_single_event");
-	buf_dblwr->first_free = 0;
 	buf_dblwr->s_reserved = 0;
-	buf_dblwr->b_reserved = 0;
 
 	buf_dblwr->block1 = mach_read_from_4(
 		doublewrite + TRX_SYS_DOUBLEWRITE_BLOCK1);
 	buf_dblwr->block2 = mach_read_from_4(
 		doublewrite + TRX_SYS_DOUBLEWRITE_BLOCK2);
 
+	/* The batch flushing slots are divided evenly between the
+	doublewrite blocks. Each block forms a segment that is written
+	with a single write request, so that a new batch can be
+	collected into one segment while the data file writes of the
+	previous batch are still pending. */
+	buf_dblwr->seg_size = std::max<ulint>(
+		srv_doublewrite_batch_size / TRX_SYS_DOUBLEWRITE_BLOCKS, 1);
+	ut_a(buf_dblwr->seg_size < TRX_SYS_DOUBLEWRITE_BLOCK_SIZE);
+	buf_dblwr->active = 0;
+
+	for (ulint i = 0; i < TRX_SYS_DOUBLEWRITE_BLOCKS; i++) {
+		buf_dblwr_seg_t&	seg = buf_dblwr->seg[i];
+		seg.start = i * TRX_SYS_DOUBLEWRITE_BLOCK_SIZE;
+		seg.page_no = i ? buf_dblwr->block2 : buf_dblwr->block1;
+		seg.first_free = 0;
+		seg.reserved = 0;
+		seg.flushing = false;
+	}
+
 	buf_dblwr->in_use = static_cast<bool*>(
 		ut_zalloc_nokey(buf_size * sizeof(bool)));
 
@@ -673,7 +697,8 @@ buf_dblwr_free()
 	/* Free the double write data structures. */
 	ut_a(buf_dblwr != NULL);
 	ut_ad(buf_dblwr->s_reserved == 0);
-	ut_ad(buf_dblwr->b_reserved == 0);
+	ut_ad(!buf_dblwr->seg[0].reserved);
+	ut_ad(!buf_dblwr->seg[1].reserved);
 
 	os_event_destroy(buf_dblwr->b_event);
 	os_event_destroy(buf_dblwr->s_event);
@@ -701,36 +726,60 @@ buf_dblwr_update(
 	switch (flush_type) {
 	case BUF_FLUSH_LIST:
 	case BUF_FLUSH_LRU:
-		mutex_enter(&buf_dblwr->mutex);
+		{
+			buf_dblwr_seg_t*	seg = NULL;
+			mutex_enter(&buf_dblwr->mutex);
 
-		ut_ad(buf_dblwr->batch_running);
-		ut_ad(buf_dblwr->b_reserved > 0);
-		ut_ad(buf_dblwr->b_reserved <= buf_dblwr->first_free);
+			/* Find the segment that the page was written
+			from. A page cannot be in more than one flushing
+			segment, because it remains io-fixed until its
+			data file write completes. */
+			for (ulint s = 0; !seg && s < TRX_SYS_DOUBLEWRITE_BLOCKS;
+			     s++) {
+				buf_dblwr_seg_t& cur = buf_dblwr->seg[s];
+				if (!cur.flushing) {
+					continue;
+				}
+				for (ulint i = cur.start;
+				     i < cur.start + cur.first_free; i++) {
+					if (buf_dblwr->buf_block_arr[i]
+					    == bpage) {
+						buf_dblwr->buf_block_arr[i]
+							= NULL;
+						seg = &cur;
+						break;
+					}
+				}
+			}
 
-		buf_dblwr->b_reserved--;
+			ut_a(seg);
+			ut_ad(seg->reserved > 0);
+			ut_ad(seg->reserved <= seg->first_free);
+
+			if (--seg->reserved == 0) {
+				mutex_exit(&buf_dblwr->mutex);
+				/* This will finish the batch. Sync data
+				files to the disk. */
+				fil_flush_file_spaces(FIL_TYPE_TABLESPACE);
+				mutex_enter(&buf_dblwr->mutex);
+
+				/* We can now reuse the segment: */
+				seg->first_free = 0;
+				seg->flushing = false;
+				os_event_set(buf_dblwr->b_event);
+			}
 
-		if (buf_dblwr->b_reserved == 0) {
 			mutex_exit(&buf_dblwr->mutex);
-			/* This will finish the batch. Sync data files
-			to the disk. */
-			fil_flush_file_spaces(FIL_TYPE_TABLESPACE);
-			mutex_enter(&buf_dblwr->mutex);
-
-			/* We can now reuse the doublewrite memory buffer: */
-			buf_dblwr->first_free = 0;
-			buf_dblwr->batch_running = false;
-			os_event_set(buf_dblwr->b_event);
 		}
-
-		mutex_exit(&buf_dblwr->mutex);
 		break;
 	case BUF_FLUSH_SINGLE_PAGE:
 		{
 			const ulint size = TRX_SYS_DOUBLEWRITE_BLOCKS * TRX_SYS_DOUBLEWRITE_BLOCK_SIZE;
 			ulint i;
 			mutex_enter(&buf_dblwr->mutex);
-			for (i = srv_doublewrite_batch_size; i < size; ++i) {
-				if (buf_dblwr->buf_block_arr[i] == bpage) {
+			for (i = 0; i < size; ++i) {
+				if (buf_dblwr_is_single_page_slot(i)
+				    && buf_dblwr->buf_block_arr[i] == bpage) {
 					buf_dblwr->s_reserved--;
 					buf_dblwr->buf_block_arr[i] = NULL;
 					buf_dblwr->in_use[i] = false;
@@ -905,7 +954,6 @@ buf_dblwr_flush_buffered_writes()
 {
 	byte*		write_buf;
 	ulint		first_free;
-	ulint		len;
 
 	if (!srv_use_doublewrite_buf || buf_dblwr == NULL) {
 		/* Sync the writes to the disk. */
@@ -920,19 +968,17 @@ buf_dblwr_flush_buffered_writes()
 try_again:
 	mutex_enter(&buf_dblwr->mutex);
 
-	/* Write first to doublewrite buffer blocks. We use synchronous
-	aio and thus know that file write has been completed when the
-	control returns. */
-
-	if (buf_dblwr->first_free == 0) {
+	buf_dblwr_seg_t&	seg = buf_dblwr->seg[buf_dblwr->active];
 
+	if (seg.first_free == 0) {
 		mutex_exit(&buf_dblwr->mutex);
 		return;
 	}
 
-	if (buf_dblwr->batch_running) {
-		/* Another thread is running the batch right now. Wait
-		for it to finish. */
+	if (seg.flushing) {
+		/* Both segments are being flushed by other threads.
+		Wait for the batch in this segment to finish, and then
+		flush whatever was collected in the other one. */
 		int64_t	sig_count = os_event_reset(buf_dblwr->b_event);
 		mutex_exit(&buf_dblwr->mutex);
 
@@ -940,23 +986,26 @@ buf_dblwr_flush_buffered_writes()
 		goto try_again;
 	}
 
-	ut_ad(buf_dblwr->first_free == buf_dblwr->b_reserved);
+	ut_ad(seg.first_free == seg.reserved);
 
-	/* Disallow anyone else to post to doublewrite buffer or to
-	start another batch of flushing. */
-	buf_dblwr->batch_running = true;
-	first_free = buf_dblwr->first_free;
+	/* Disallow anyone else to post to this segment. New pages will
+	be collected in the other segment once its previous batch has
+	completed. */
+	seg.flushing = true;
+	first_free = seg.first_free;
+	buf_dblwr->active = (buf_dblwr->active + 1)
+		% TRX_SYS_DOUBLEWRITE_BLOCKS;
 
 	/* Now safe to release the mutex. Note that though no other
-	thread is allowed to post to the doublewrite batch flushing
-	but any threads working on single page flushes are allowed
+	thread is allowed to post to this segment, any threads working
+	on the other segment or on single page flushes are allowed
 	to proceed. */
 	mutex_exit(&buf_dblwr->mutex);
 
-	write_buf = buf_dblwr->write_buf;
+	write_buf = buf_dblwr->write_buf + (seg.start << srv_page_size_shift);
 
-	for (ulint len2 = 0, i = 0;
-	     i < buf_dblwr->first_free;
+	for (ulint len2 = 0, i = seg.start;
+	     i < seg.start + first_free;
 	     len2 += srv_page_size, i++) {
 
 		const buf_block_t*	block;
@@ -976,33 +1025,15 @@ buf_dblwr_flush_buffered_writes()
 		ut_d(buf_dblwr_check_page_lsn(block->page, write_buf + len2));
 	}
 
-	/* Write out the first block of the doublewrite buffer */
-	len = std::min<ulint>(TRX_SYS_DOUBLEWRITE_BLOCK_SIZE,
-			      buf_dblwr->first_free) << srv_page_size_shift;
-
-	fil_io(IORequestWrite, true,
-	       page_id_t(TRX_SYS_SPACE, buf_dblwr->block1), 0,
-	       0, len, (void*) write_buf, NULL);
-
-	if (buf_dblwr->first_free <= TRX_SYS_DOUBLEWRITE_BLOCK_SIZE) {
-		/* No unwritten pages in the second block. */
-		goto flush;
-	}
-
-	/* Write out the second block of the doublewrite buffer. */
-	len = (buf_dblwr->first_free - TRX_SYS_DOUBLEWRITE_BLOCK_SIZE)
-	       << srv_page_size_shift;
-
-	write_buf = buf_dblwr->write_buf
-		+ (TRX_SYS_DOUBLEWRITE_BLOCK_SIZE << srv_page_size_shift);
-
+	/* Write out the segment with a single request. We use
+	synchronous aio and thus know that file write has been completed
+	when the control returns. */
 	fil_io(IORequestWrite, true,
-	       page_id_t(TRX_SYS_SPACE, buf_dblwr->block2), 0,
-	       0, len, (void*) write_buf, NULL);
+	       page_id_t(TRX_SYS_SPACE, seg.page_no), 0,
+	       0, first_free << srv_page_size_shift, (void*) write_buf, NULL);
 
-flush:
 	/* increment the doublewrite flushed pages counter */
-	srv_stats.dblwr_pages_written.add(buf_dblwr->first_free);
+	srv_stats.dblwr_pages_written.add(first_free);
 	srv_stats.dblwr_writes.inc();
 
 	/* Now flush the doublewrite buffer data to disk */
@@ -1012,21 +1043,20 @@ buf_dblwr_flush_buffered_writes()
 	and in recovery we will find them in the doublewrite buffer
 	blocks. Next do the writes to the intended positions. */
 
-	/* Up to this point first_free and buf_dblwr->first_free are
-	same because we have set the buf_dblwr->batch_running flag
-	disallowing any other thread to post any request but we
-	can't safely access buf_dblwr->first_free in the loop below.
-	This is so because it is possible that after we are done with
-	the last iteration and before we terminate the loop, the batch
-	gets finished in the IO helper thread and another thread posts
-	a new batch setting buf_dblwr->first_free to a higher value.
-	If this happens and we are using buf_dblwr->first_free in the
-	loop termination condition then we'll end up dispatching
-	the same block twice from two different threads. */
-	ut_ad(first_free == buf_dblwr->first_free);
+	/* Each slot is read before its page is posted, and the slot is
+	only reset in buf_dblwr_update() when that write completes. We
+	must not access seg.first_free here: once the last write has
+	completed in an IO helper thread, another batch may be posted
+	to the segment. */
+	buf_page_t**	pages = buf_dblwr->buf_block_arr + seg.start;
+
+	/* Keep the data file writes of this segment pending, so that
+	the server is killed in buf_dblwr_add_to_batch() while the
+	other segment is being filled. */
+	DBUG_EXECUTE_IF("ib_dblwr_crash_while_filling", return;);
+
 	for (ulint i = 0; i < first_free; i++) {
-		buf_dblwr_write_block_to_datafile(
-			buf_dblwr->buf_block_arr[i], false);
+		buf_dblwr_write_block_to_datafile(pages[i], false);
 	}
 }
 
@@ -1044,16 +1074,18 @@ buf_dblwr_add_to_batch(
 try_again:
 	mutex_enter(&buf_dblwr->mutex);
 
-	ut_a(buf_dblwr->first_free <= srv_doublewrite_batch_size);
+	buf_dblwr_seg_t&	seg = buf_dblwr->seg[buf_dblwr->active];
 
-	if (buf_dblwr->batch_running) {
+	ut_a(seg.first_free <= buf_dblwr->seg_size);
 
-		/* This not nearly as bad as it looks. There is only
-		page_cleaner thread which does background flushing
-		in batches therefore it is unlikely to be a contention
-		point. The only exception is when a user thread is
-		forced to do a flush batch because of a sync
-		checkpoint. */
+	if (seg.flushing) {
+
+		/* The data file writes of the previous batch in this
+		segment are still pending. There is only page_cleaner
+		thread which does background flushing in batches
+		therefore it is unlikely to be a contention point. The
+		only exception is when a user thread is forced to do a
+		flush batch because of a sync checkpoint. */
 		int64_t	sig_count = os_event_reset(buf_dblwr->b_event);
 		mutex_exit(&buf_dblwr->mutex);
 
@@ -1061,7 +1093,7 @@ buf_dblwr_add_to_batch(
 		goto try_again;
 	}
 
-	if (buf_dblwr->first_free == srv_doublewrite_batch_size) {
+	if (seg.first_free == buf_dblwr->seg_size) {
 		mutex_exit(&(buf_dblwr->mutex));
 
 		buf_dblwr_flush_buffered_writes();
@@ -1069,8 +1101,8 @@ buf_dblwr_add_to_batch(
 		goto try_again;
 	}
 
-	byte*	p = buf_dblwr->write_buf
-		+ srv_page_size * buf_dblwr->first_free;
+	const ulint	slot = seg.start + seg.first_free;
+	byte*	p = buf_dblwr->write_buf + srv_page_size * slot;
 
 	/* We request frame here to get correct buffer in case of
 	encryption and/or page compression */
@@ -1089,16 +1121,23 @@ buf_dblwr_add_to_batch(
 						       srv_page_size);
 	}
 
-	buf_dblwr->buf_block_arr[buf_dblwr->first_free] = bpage;
+	buf_dblwr->buf_block_arr[slot] = bpage;
+
+	seg.first_free++;
+	seg.reserved++;
 
-	buf_dblwr->first_free++;
-	buf_dblwr->b_reserved++;
+	ut_ad(!seg.flushing);
+	ut_ad(seg.first_free == seg.reserved);
+	ut_ad(seg.reserved <= buf_dblwr->seg_size);
 
-	ut_ad(!buf_dblwr->batch_running);
-	ut_ad(buf_dblwr->first_free == buf_dblwr->b_reserved);
-	ut_ad(buf_dblwr->b_reserved <= srv_doublewrite_batch_size);
+	DBUG_EXECUTE_IF("ib_dblwr_crash_while_filling",
+			if (buf_dblwr->seg[(buf_dblwr->active + 1)
+					   % TRX_SYS_DOUBLEWRITE_BLOCKS]
+			    .flushing) {
+				DBUG_SUICIDE();
+			});
 
-	if (buf_dblwr->first_free == srv_doublewrite_batch_size) {
+	if (seg.first_free == buf_dblwr->seg_size) {
 		mutex_exit(&(buf_dblwr->mutex));
 
 		buf_dblwr_flush_buffered_writes();
@@ -1132,12 +1171,10 @@ buf_dblwr_write_single_page(
 	ut_a(srv_use_doublewrite_buf);
 	ut_a(buf_dblwr != NULL);
 
-	/* total number of slots available for single page flushes
-	starts from srv_doublewrite_batch_size to the end of the
-	buffer. */
+	/* The slots available for single page flushes are those
+	past the batch flushing segment in each doublewrite block. */
 	size = TRX_SYS_DOUBLEWRITE_BLOCKS * TRX_SYS_DOUBLEWRITE_BLOCK_SIZE;
-	ut_a(size > srv_doublewrite_batch_size);
-	n_slots = size - srv_doublewrite_batch_size;
+	n_slots = size - TRX_SYS_DOUBLEWRITE_BLOCKS * buf_dblwr->seg_size;
 
 	if (buf_page_get_state(bpage) == BUF_BLOCK_FILE_PAGE) {
 
@@ -1165,9 +1202,10 @@ buf_dblwr_write_single_page(
 		goto retry;
 	}
 
-	for (i = srv_doublewrite_batch_size; i < size; ++i) {
+	for (i = 0; i < size; ++i) {
 
-		if (!buf_dblwr->in_use[i]) {
+		if (buf_dblwr_is_single_page_slot(i)
+		    && !buf_dblwr->in_use[i]) {
 			break;
 		}
 	}
@@ -2534,6 +2534,43 @@ af_get_pct_for_lsn(
 		/ 7.5));
 }
 
+/** Accumulated distance of the checkpoint age from
+innodb_adaptive_flushing_target, in LSN units */
+static double af_age_integral;
+
+/** Calculates the flushing rate that keeps the checkpoint age at
+innodb_adaptive_flushing_target. The checkpoint must advance at the
+rate of redo log generation, plus a correction that is proportional to
+the distance from the setpoint and to the accumulated distance, so that
+a persistent deviation is eliminated over innodb_flushing_avg_loops
+iterations.
+@param[in]	age		current checkpoint age
+@param[in]	pages_per_lsn	number of dirty pages per LSN unit
+				at the tail of the flush lists
+@return number of pages to flush in the next second */
+static
+ulint
+af_get_pages_for_target(
+	lsn_t	age,
+	double	pages_per_lsn)
+{
+	const double	capacity = double(log_get_capacity());
+	const double	setpoint = srv_adaptive_flushing_target
+		* capacity / 100;
+	const double	loops = double(srv_flushing_avg_loops);
+	const double	error = double(age) - setpoint;
+
+	/* Bound the accumulated error, so that the controller
+	will not wind up while the flushing is saturated. */
+	af_age_integral = std::min(std::max(af_age_integral + error,
+					    -capacity), capacity);
+
+	const double	rate = double(lsn_avg_rate)
+		+ (error + af_age_integral / loops) / loops;
+
+	return rate > 0 ? static_cast<ulint>(rate * pages_per_lsn) : 0;
+}
+
 /*********************************************************************//**
 This function is called approximately once every second by the
 page_cleaner thread. Based on various factors it decides if there is a
@@ -2734,6 +2771,23 @@ page_cleaner_flush_pages_recommendation(
 		mutex_exit(&page_cleaner.mutex);
 	}
 
+	/* While no redo log is being generated (lsn_avg_rate == 0) or
+	nothing is dirty, af_age_integral is kept, so that a deviation from
+	the setpoint is still corrected when writes resume. It is only
+	reset when innodb_adaptive_flushing_target is disabled. */
+	const bool	use_target = srv_adaptive_flushing_target > 0
+		&& oldest_lsn && target_lsn > oldest_lsn;
+
+	if (use_target) {
+		n_pages = std::max(
+			af_get_pages_for_target(
+				age, double(sum_pages_for_lsn)
+				/ double(target_lsn - oldest_lsn)),
+			PCT_IO(pct_for_dirty));
+	} else if (srv_adaptive_flushing_target == 0) {
+		af_age_integral = 0;
+	}
+
 	sum_pages_for_lsn /= buf_flush_lsn_scan_factor;
 	if(sum_pages_for_lsn < 1) {
 		sum_pages_for_lsn = 1;
@@ -2744,7 +2798,10 @@ page_cleaner_flush_pages_recommendation(
 	ulint	pages_for_lsn =
 		std::min<ulint>(sum_pages_for_lsn, srv_max_io_capacity * 2);
 
-	n_pages = (PCT_IO(pct_total) + avg_page_rate + pages_for_lsn) / 3;
+	if (!use_target) {
+		n_pages = (PCT_IO(pct_total) + avg_page_rate
+			   + pages_for_lsn) / 3;
+	}
 
 	if (n_pages > srv_max_io_capacity) {
 		n_pages = srv_max_io_capacity;
@@ -2759,7 +2816,8 @@ page_cleaner_flush_pages_recommendation(
 	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
 		/* if REDO has enough of free space,
 		don't care about age distribution of pages */
-		page_cleaner.slots[i].n_pages_requested = pct_for_lsn > 30 ?
+		page_cleaner.slots[i].n_pages_requested
+			= pct_for_lsn > 30 || use_target ?
 			page_cleaner.slots[i].n_pages_requested
 			* n_pages / sum_pages_for_lsn + 1
 			: n_pages / srv_buf_pool_instances;
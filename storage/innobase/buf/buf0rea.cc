@@ -330,6 +330,8 @@ buf_read_ahead_random(const page_id_t page_id, ulint zip_size, bool ibuf)
 	ibuf_mode = ibuf ? BUF_READ_IBUF_PAGES_ONLY : BUF_READ_ANY_PAGE;
 	count = 0;
 
+	os_aio_batch_begin();
+
 	for (i = low; i < high; i++) {
 		/* It is only sensible to do read-ahead in the non-sync aio
 		mode: hence FALSE as the first parameter */
@@ -358,6 +360,7 @@ buf_read_ahead_random(const page_id_t page_id, ulint zip_size, bool ibuf)
 		}
 	}
 
+	os_aio_batch_end();
 
 	if (count) {
 		DBUG_PRINT("ib_buf", ("random read-ahead %u pages, %u:%u",
@@ -690,6 +693,8 @@ buf_read_ahead_linear(const page_id_t page_id, ulint zip_size, bool ibuf)
 
 	ulint ibuf_mode = ibuf ? BUF_READ_IBUF_PAGES_ONLY : BUF_READ_ANY_PAGE;
 
+	os_aio_batch_begin();
+
 	for (i = low; i < high; i++) {
 		/* It is only sensible to do read-ahead in the non-sync
 		aio mode: hence FALSE as the first parameter */
@@ -718,6 +723,8 @@ buf_read_ahead_linear(const page_id_t page_id, ulint zip_size, bool ibuf)
 		}
 	}
 
+	os_aio_batch_end();
+
 	if (count) {
 		DBUG_PRINT("ib_buf", ("linear read-ahead " ULINTPF " pages, "
 				      "%u:%u",
@@ -734,6 +741,83 @@ buf_read_ahead_linear(const page_id_t page_id, ulint zip_size, bool ibuf)
 	return(count);
 }
 
+/** Issue asynchronous read requests for leaf pages that an index range
+scan is about to access in key order. Unlike buf_read_ahead_linear(),
+this does not depend on the physical placement of the pages.
+NOTE: the calling thread must not hold any page latches.
+@param[in]	space_id	tablespace identifier
+@param[in]	zip_size	ROW_FORMAT=COMPRESSED page size, or 0
+@param[in]	page_nos	page numbers to read, in key order
+@param[in]	n		number of elements in page_nos
+@return number of page read requests issued */
+ulint
+buf_read_ahead_logical(ulint space_id, ulint zip_size,
+		       const uint32_t* page_nos, ulint n)
+{
+	if (srv_startup_is_before_trx_rollback_phase) {
+		/* No read-ahead to avoid thread deadlocks */
+		return(0);
+	}
+
+	ulint	count = 0;
+	dberr_t	err = DB_SUCCESS;
+
+	os_aio_batch_begin();
+
+	for (ulint i = 0; i < n; i++) {
+		const page_id_t	page_id(space_id, page_nos[i]);
+		buf_pool_t*	buf_pool = buf_pool_get(page_id);
+
+		buf_pool_mutex_enter(buf_pool);
+
+		if (buf_pool->n_pend_reads
+		    > buf_pool->curr_size / BUF_READ_AHEAD_PEND_LIMIT) {
+			/* Too many pending reads; do not add to them. */
+			buf_pool_mutex_exit(buf_pool);
+			break;
+		}
+
+		buf_pool_mutex_exit(buf_pool);
+
+		ulint		n_read = buf_read_page_low(
+			&err, false, BUF_READ_ANY_PAGE, page_id, zip_size,
+			false);
+
+		switch (err) {
+		case DB_SUCCESS:
+		case DB_ERROR:
+			break;
+		case DB_TABLESPACE_DELETED:
+			i = n;
+			break;
+		case DB_PAGE_CORRUPTED:
+		case DB_DECRYPTION_FAILED:
+			ib::error() << "logical readahead failed to"
+				" read or decrypt " << page_id;
+			break;
+		default:
+			ut_error;
+		}
+
+		buf_pool->stat.n_ra_pages_read += n_read;
+		count += n_read;
+	}
+
+	os_aio_batch_end();
+
+	if (count) {
+		DBUG_PRINT("ib_buf", ("logical read-ahead " ULINTPF " pages"
+				      " of space " ULINTPF,
+				      count, space_id));
+
+		/* Read ahead is considered one I/O operation for the
+		purpose of LRU policy decision. */
+		buf_LRU_stat_inc_io();
+	}
+
+	return(count);
+}
+
 /** Issues read requests for pages which recovery wants to read in.
 @param[in]	sync		true if the caller wants this function to wait
 for the highest address page to get read in, before this function returns
@@ -251,7 +251,9 @@ ha_insert_for_fold_func(
 
 			prev_node->block = block;
 #endif /* UNIV_AHI_DEBUG || UNIV_DEBUG */
+			ha_modify_start(table);
 			prev_node->data = data;
+			ha_modify_end(table);
 
 			return(TRUE);
 		}
@@ -259,12 +261,23 @@ ha_insert_for_fold_func(
 		prev_node = prev_node->next;
 	}
 
-	/* We have to allocate a new chain node */
+	/* We have to allocate a new chain node, or reuse a deleted one */
 
-	node = static_cast<ha_node_t*>(
-		mem_heap_alloc(hash_get_heap(table, fold), sizeof(ha_node_t)));
+	ha_modify_start(table);
+
+	node = static_cast<ha_node_t*>(table->free_nodes);
+
+	if (node != NULL) {
+		table->free_nodes = node->next;
+	} else {
+		node = static_cast<ha_node_t*>(
+			mem_heap_alloc(hash_get_heap(table, fold),
+				       sizeof(ha_node_t)));
+	}
 
 	if (node == NULL) {
+		ha_modify_end(table);
+
 		/* It was a btr search type memory heap and at the moment
 		no more memory could be allocated: return */
 
@@ -290,16 +303,16 @@ ha_insert_for_fold_func(
 	if (prev_node == NULL) {
 
 		cell->node = node;
+	} else {
+		while (prev_node->next != NULL) {
 
-		return(TRUE);
-	}
-
-	while (prev_node->next != NULL) {
+			prev_node = prev_node->next;
+		}
 
-		prev_node = prev_node->next;
+		prev_node->next = node;
 	}
 
-	prev_node->next = node;
+	ha_modify_end(table);
 
 	return(TRUE);
 }
@@ -324,7 +337,9 @@ ha_btr_search_latch_x_locked(const hash_table_t* table)
 #endif /* UNIV_DEBUG */
 
 /***********************************************************//**
-Deletes a hash node. */
+Deletes a hash node. The node is not freed but kept for reuse by
+ha_insert_for_fold_func(), because a search without the latch
+may be looking at it. */
 void
 ha_delete_hash_node(
 /*================*/
@@ -342,7 +357,11 @@ ha_delete_hash_node(
 	}
 #endif /* UNIV_AHI_DEBUG || UNIV_DEBUG */
 
-	HASH_DELETE_AND_COMPACT(ha_node_t, next, table, del_node);
+	ha_modify_start(table);
+	HASH_DELETE(ha_node_t, next, table, del_node->fold, del_node);
+	del_node->next = static_cast<ha_node_t*>(table->free_nodes);
+	table->free_nodes = del_node;
+	ha_modify_end(table);
 }
 
 /*********************************************************//**
@@ -386,7 +405,9 @@ ha_search_and_update_if_found_func(
 
 		node->block = new_block;
 #endif /* UNIV_AHI_DEBUG || UNIV_DEBUG */
+		ha_modify_start(table);
 		node->data = new_data;
+		ha_modify_end(table);
 
 		return(TRUE);
 	}
@@ -414,20 +435,17 @@ ha_remove_all_nodes_to_page(
 	node = ha_chain_get_first(table, fold);
 
 	while (node) {
+		/* The deletion will reuse the next pointer */
+		ha_node_t*	next = ha_chain_get_next(node);
+
 		if (page_align(ha_node_get_data(node)) == page) {
 
 			/* Remove the hash node */
 
 			ha_delete_hash_node(table, node);
-
-			/* Start again from the first node in the chain
-			because the deletion may compact the heap of
-			nodes and move other nodes! */
-
-			node = ha_chain_get_first(table, fold);
-		} else {
-			node = ha_chain_get_next(node);
 		}
+
+		node = next;
 	}
 #ifdef UNIV_DEBUG
 	/* Check that all nodes really got deleted */
@@ -118,6 +118,8 @@ hash_create(
 # if defined UNIV_AHI_DEBUG || defined UNIV_DEBUG
 	table->adaptive = FALSE;
 # endif /* UNIV_AHI_DEBUG || UNIV_DEBUG */
+	table->n_modified = 0;
+	table->free_nodes = NULL;
 #endif /* BTR_CUR_HASH_ADAPT */
 	table->n_sync_obj = 0;
 	table->sync_obj.mutexes = NULL;
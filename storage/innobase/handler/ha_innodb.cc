@@ -377,6 +377,25 @@ TYPELIB innodb_flush_method_typelib = {
 	NULL
 };
 
+#ifdef __linux__
+/** Names of allowed values of innodb_linux_aio,
+in the order of tpool::aio_implementation */
+static const char* innodb_linux_aio_names[] = {
+	"auto",
+	"io_uring",
+	"aio",
+	NullS
+};
+
+/** Enumeration of innodb_linux_aio */
+static TYPELIB innodb_linux_aio_typelib = {
+	array_elements(innodb_linux_aio_names) - 1,
+	"innodb_linux_aio_typelib",
+	innodb_linux_aio_names,
+	NULL
+};
+#endif /* __linux__ */
+
 /* The following counter is used to convey information to InnoDB
 about server activity: in case of normal DML ops it is not
 sensible to call srv_active_wake_master_thread after each
@@ -553,7 +572,6 @@ static PSI_mutex_info all_innodb_mutexes[] = {
 	PSI_KEY(trx_pool_mutex),
 	PSI_KEY(trx_pool_manager_mutex),
 	PSI_KEY(srv_sys_mutex),
-	PSI_KEY(lock_mutex),
 	PSI_KEY(lock_wait_mutex),
 	PSI_KEY(trx_mutex),
 	PSI_KEY(srv_threads_mutex),
@@ -590,7 +608,8 @@ static PSI_rwlock_info all_innodb_rwlocks[] = {
 	PSI_RWLOCK_KEY(index_tree_rw_lock),
 	PSI_RWLOCK_KEY(index_online_log),
 	PSI_RWLOCK_KEY(dict_table_stats),
-	PSI_RWLOCK_KEY(hash_table_locks)
+	PSI_RWLOCK_KEY(hash_table_locks),
+	PSI_RWLOCK_KEY(lock_sys_latch)
 };
 # endif /* UNIV_PFS_RWLOCK */
 
@@ -879,7 +898,11 @@ static MYSQL_THDVAR_STR(tmpdir,
 static SHOW_VAR innodb_status_variables[]= {
 #ifdef BTR_CUR_HASH_ADAPT
   {"adaptive_hash_hash_searches", &btr_cur_n_sea, SHOW_SIZE_T},
+  {"adaptive_hash_indexes_disabled", &btr_search_n_index_disabled,
+   SHOW_SIZE_T},
   {"adaptive_hash_non_hash_searches", &btr_cur_n_non_sea, SHOW_SIZE_T},
+  {"adaptive_hash_unlatched_retries", &btr_search_n_unlatched_retries,
+   SHOW_SIZE_T},
 #endif
   {"background_log_sync", &srv_log_writes_and_flush, SHOW_SIZE_T},
 #if defined(LINUX_NATIVE_AIO)
@@ -954,6 +977,7 @@ static SHOW_VAR innodb_status_variables[]= {
    SHOW_SIZE_T},
   {"ibuf_discarded_inserts", &ibuf.n_discarded_ops[IBUF_OP_INSERT],
    SHOW_SIZE_T},
+  {"ibuf_background_merges", &ibuf.n_background_merges, SHOW_SIZE_T},
   {"ibuf_free_list", &ibuf.free_list_len, SHOW_SIZE_T},
   {"ibuf_merged_delete_marks", &ibuf.n_merged_ops[IBUF_OP_DELETE_MARK],
    SHOW_SIZE_T},
@@ -962,6 +986,8 @@ static SHOW_VAR innodb_status_variables[]= {
   {"ibuf_merges", &ibuf.n_merges, SHOW_SIZE_T},
   {"ibuf_segment_size", &ibuf.seg_size, SHOW_SIZE_T},
   {"ibuf_size", &ibuf.size, SHOW_SIZE_T},
+  {"lock_releases_exclusive", &lock_sys.n_release_exclusive, SHOW_SIZE_T},
+  {"lock_releases_shared", &lock_sys.n_release_shared, SHOW_SIZE_T},
   {"log_waits", &export_vars.innodb_log_waits, SHOW_SIZE_T},
   {"log_write_requests", &export_vars.innodb_log_write_requests, SHOW_SIZE_T},
   {"log_writes", &export_vars.innodb_log_writes, SHOW_SIZE_T},
@@ -3863,7 +3889,7 @@ static int innodb_init_params()
 		srv_use_doublewrite_buf = FALSE;
 	}
 
-#ifdef LINUX_NATIVE_AIO
+#if defined LINUX_NATIVE_AIO || defined HAVE_URING
 	if (srv_use_native_aio) {
 		ib::info() << "Using Linux native AIO";
 	}
@@ -13969,6 +13995,60 @@ ha_innobase::rename_table(
 	DBUG_RETURN(convert_error_code_to_mysql(error, 0, NULL));
 }
 
+/*********************************************************************//**
+Reads ahead the leaf page of an index on which a search for a key value
+would end up, without waiting for the read to complete. */
+
+void
+ha_innobase::prefetch_index_read(
+/*=============================*/
+	uint		keynr,		/*!< in: index number */
+	const uchar*	key,		/*!< in: key value */
+	uint		key_len)	/*!< in: key value length */
+{
+	dict_index_t*	index;
+	dtuple_t*	tuple;
+	mem_heap_t*	heap;
+
+	DBUG_ENTER("ha_innobase::prefetch_index_read");
+
+	index = innobase_get_index(keynr);
+
+	if (!index
+	    || !m_prebuilt->table->space
+	    || !m_prebuilt->table->is_readable()
+	    || index->is_corrupted()
+	    || dict_index_is_spatial(index)
+	    || srv_read_only_mode
+	    || !row_merge_is_index_usable(m_prebuilt->trx, index)) {
+		DBUG_VOID_RETURN;
+	}
+
+	const KEY*	key_info = table->key_info + keynr;
+
+	heap = mem_heap_create(key_info->ext_key_parts * sizeof(dfield_t)
+			       + sizeof(dtuple_t));
+
+	tuple = dtuple_create(heap, key_info->ext_key_parts);
+	dict_index_copy_types(tuple, index, key_info->ext_key_parts);
+
+	row_sel_convert_mysql_key_to_innobase(
+		tuple,
+		m_prebuilt->srch_key_val1,
+		m_prebuilt->srch_key_val_len,
+		index,
+		(byte*) key,
+		(ulint) key_len);
+
+	if (dtuple_get_n_fields(tuple)) {
+		btr_cur_prefetch_leaf(index, tuple);
+	}
+
+	mem_heap_free(heap);
+
+	DBUG_VOID_RETURN;
+}
+
 /*********************************************************************//**
 Estimates the number of index records in a range.
 @return estimated number of rows */
@@ -19294,6 +19374,13 @@ static MYSQL_SYSVAR_DOUBLE(adaptive_flushing_lwm,
   "Percentage of log capacity below which no adaptive flushing happens.",
   NULL, NULL, 10.0, 0.0, 70.0, 0);
 
+static MYSQL_SYSVAR_DOUBLE(adaptive_flushing_target,
+  srv_adaptive_flushing_target,
+  PLUGIN_VAR_RQCMDARG,
+  "Percentage of log capacity at which adaptive flushing tries to keep"
+  " the checkpoint age (0 = use the dirty page and redo rate heuristics).",
+  NULL, NULL, 0.0, 0.0, 70.0, 0);
+
 static MYSQL_SYSVAR_BOOL(adaptive_flushing, srv_adaptive_flushing,
   PLUGIN_VAR_NOCMDARG,
   "Attempt flushing dirty pages to avoid IO bursts at checkpoints.",
@@ -19464,12 +19551,13 @@ static MYSQL_SYSVAR_ULONG(buffer_pool_chunk_size, srv_buf_pool_chunk_unit,
   NULL, NULL,
   128 * 1024 * 1024, 1024 * 1024, LONG_MAX, 1024 * 1024);
 
-#if defined UNIV_DEBUG || defined UNIV_PERF_DEBUG
 static MYSQL_SYSVAR_ULONG(page_hash_locks, srv_n_page_hash_locks,
   PLUGIN_VAR_OPCMDARG | PLUGIN_VAR_READONLY,
-  "Number of rw_locks protecting buffer pool page_hash. Rounded up to the next power of 2",
-  NULL, NULL, 16, 1, MAX_PAGE_HASH_LOCKS, 0);
+  "Number of rw_locks protecting buffer pool page_hash. Rounded up to the next power of 2."
+  " 0 (the default) means one per 256 pages of a buffer pool instance, at least 16",
+  NULL, NULL, 0, 0, MAX_PAGE_HASH_LOCKS, 0);
 
+#if defined UNIV_DEBUG || defined UNIV_PERF_DEBUG
 static MYSQL_SYSVAR_ULONG(doublewrite_batch_size, srv_doublewrite_batch_size,
   PLUGIN_VAR_OPCMDARG | PLUGIN_VAR_READONLY,
   "Number of pages reserved in doublewrite buffer for batch flushing",
@@ -19686,6 +19774,11 @@ static MYSQL_SYSVAR_ULONG(sort_buffer_size, srv_sort_buf_size,
   "Memory buffer size for index creation",
   NULL, NULL, 1048576, 65536, 64<<20, 0);
 
+static MYSQL_SYSVAR_ULONG(merge_sort_threads, srv_merge_sort_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of threads for merging the sorted runs in index creation",
+  NULL, NULL, 4, 1, 64, 0);
+
 static MYSQL_SYSVAR_ULONGLONG(online_alter_log_max_size, srv_online_max_size,
   PLUGIN_VAR_RQCMDARG,
   "Maximum modification log file size for online index creation",
@@ -19711,6 +19804,12 @@ static MYSQL_SYSVAR_ULONG(force_recovery, srv_force_recovery,
   "Helps to save your data in case the disk image of the database becomes corrupt. Value 5 can return bogus data, and 6 can permanently corrupt data.",
   NULL, NULL, 0, 0, 6, 0);
 
+static MYSQL_SYSVAR_ULONG(recovery_apply_tasks, srv_recovery_apply_tasks,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Number of tasks that apply the redo log to buffer pool pages"
+  " in parallel during crash recovery (0=apply in the recovery thread)",
+  NULL, NULL, 0, 0, 256, 0);
+
 static MYSQL_SYSVAR_ULONG(page_size, srv_page_size,
   PLUGIN_VAR_OPCMDARG | PLUGIN_VAR_READONLY,
   "Page size to use for all InnoDB tablespaces.",
@@ -19864,6 +19963,16 @@ static MYSQL_SYSVAR_BOOL(use_native_aio, srv_use_native_aio,
   "Use native AIO if supported on this platform.",
   NULL, NULL, TRUE);
 
+#ifdef __linux__
+static MYSQL_SYSVAR_ENUM(linux_aio, srv_linux_aio,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Native AIO implementation to use with innodb_use_native_aio=ON:"
+  " auto (io_uring if available, otherwise aio),"
+  " io_uring (fall back to aio if io_uring is not available),"
+  " aio (libaio). After startup, the implementation in use.",
+  NULL, NULL, 0, &innodb_linux_aio_typelib);
+#endif /* __linux__ */
+
 #ifdef HAVE_LIBNUMA
 static MYSQL_SYSVAR_BOOL(numa_interleave, srv_numa_interleave,
   PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
@@ -19884,6 +19993,13 @@ static MYSQL_SYSVAR_UINT(change_buffer_max_size,
   NULL, innodb_change_buffer_max_size_update,
   CHANGE_BUFFER_DEFAULT_SIZE, 0, 50, 0);
 
+static MYSQL_SYSVAR_UINT(change_buffer_merge_pct,
+  srv_change_buffer_merge_pct,
+  PLUGIN_VAR_RQCMDARG,
+  "Percentage of innodb_io_capacity used for merging the change buffer"
+  " in the background (0 = merge only when pages are read).",
+  NULL, NULL, 0, 0, 100, 0);
+
 static MYSQL_SYSVAR_ENUM(stats_method, srv_innodb_stats_method,
    PLUGIN_VAR_RQCMDARG,
   "Specifies how InnoDB index statistics collection code should"
@@ -19955,6 +20071,12 @@ static MYSQL_SYSVAR_ULONG(read_ahead_threshold, srv_read_ahead_threshold,
   " trigger a readahead.",
   NULL, NULL, 56, 0, 64, 0);
 
+static MYSQL_SYSVAR_ULONG(logical_read_ahead, srv_logical_read_ahead,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of leaf pages to read ahead in key order in ascending index"
+  " range scans (0 = disabled).",
+  NULL, NULL, 0, 0, 256, 0);
+
 static MYSQL_SYSVAR_STR(monitor_enable, innobase_enable_monitor_counter,
   PLUGIN_VAR_RQCMDARG,
   "Turn on a monitor counter",
@@ -20287,6 +20409,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(flush_log_at_trx_commit),
   MYSQL_SYSVAR(flush_method),
   MYSQL_SYSVAR(force_recovery),
+  MYSQL_SYSVAR(recovery_apply_tasks),
   MYSQL_SYSVAR(fill_factor),
   MYSQL_SYSVAR(ft_cache_size),
   MYSQL_SYSVAR(ft_total_cache_size),
@@ -20312,6 +20435,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(max_dirty_pages_pct),
   MYSQL_SYSVAR(max_dirty_pages_pct_lwm),
   MYSQL_SYSVAR(adaptive_flushing_lwm),
+  MYSQL_SYSVAR(adaptive_flushing_target),
   MYSQL_SYSVAR(adaptive_flushing),
   MYSQL_SYSVAR(flush_sync),
   MYSQL_SYSVAR(flushing_avg_loops),
@@ -20343,6 +20467,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(status_file),
   MYSQL_SYSVAR(strict_mode),
   MYSQL_SYSVAR(sort_buffer_size),
+  MYSQL_SYSVAR(merge_sort_threads),
   MYSQL_SYSVAR(online_alter_log_max_size),
   MYSQL_SYSVAR(sync_spin_loops),
   MYSQL_SYSVAR(spin_wait_delay),
@@ -20355,11 +20480,15 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(autoinc_lock_mode),
   MYSQL_SYSVAR(version),
   MYSQL_SYSVAR(use_native_aio),
+#ifdef __linux__
+  MYSQL_SYSVAR(linux_aio),
+#endif /* __linux__ */
 #ifdef HAVE_LIBNUMA
   MYSQL_SYSVAR(numa_interleave),
 #endif /* HAVE_LIBNUMA */
   MYSQL_SYSVAR(change_buffering),
   MYSQL_SYSVAR(change_buffer_max_size),
+  MYSQL_SYSVAR(change_buffer_merge_pct),
 #if defined UNIV_DEBUG || defined UNIV_IBUF_DEBUG
   MYSQL_SYSVAR(change_buffer_dump),
   MYSQL_SYSVAR(change_buffering_debug),
@@ -20369,6 +20498,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
 #endif /* WITH_INNODB_DISALLOW_WRITES */
   MYSQL_SYSVAR(random_read_ahead),
   MYSQL_SYSVAR(read_ahead_threshold),
+  MYSQL_SYSVAR(logical_read_ahead),
   MYSQL_SYSVAR(read_only),
   MYSQL_SYSVAR(io_capacity),
   MYSQL_SYSVAR(io_capacity_max),
@@ -20386,8 +20516,8 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(buf_flush_list_now),
   MYSQL_SYSVAR(merge_threshold_set_all_debug),
 #endif /* UNIV_DEBUG */
-#if defined UNIV_DEBUG || defined UNIV_PERF_DEBUG
   MYSQL_SYSVAR(page_hash_locks),
+#if defined UNIV_DEBUG || defined UNIV_PERF_DEBUG
   MYSQL_SYSVAR(doublewrite_batch_size),
 #endif /* defined UNIV_DEBUG || defined UNIV_PERF_DEBUG */
   MYSQL_SYSVAR(status_output),
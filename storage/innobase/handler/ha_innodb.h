@@ -124,6 +124,11 @@ class ha_innobase final: public handler
 
 	void unlock_row() override;
 
+	void prefetch_index_read(
+		uint			keynr,
+		const uchar*		key,
+		uint			key_len) override;
+
 	int index_init(uint index, bool sorted) override;
 
 	int index_end() override;
@@ -2257,12 +2257,13 @@ ibuf_get_user_rec(
 Reads page numbers for a space id from an ibuf tree.
 @return a lower limit for the combined volume of records which will be
 merged */
-static	MY_ATTRIBUTE((nonnull, warn_unused_result))
+static	MY_ATTRIBUTE((nonnull))
 ulint
 ibuf_get_merge_pages(
 /*=================*/
 	btr_pcur_t*	pcur,	/*!< in/out: cursor */
-	ulint		space,	/*!< in: space for which to merge */
+	ulint		space,	/*!< in: space for which to merge,
+				or ULINT_UNDEFINED for any space */
 	ulint		limit,	/*!< in: max page numbers to read */
 	ulint*		pages,	/*!< out: pages read */
 	ulint*		spaces,	/*!< out: spaces read */
@@ -2272,18 +2273,27 @@ ibuf_get_merge_pages(
 	const rec_t*	rec;
 	ulint		volume = 0;
 
-	ut_a(space != ULINT_UNDEFINED);
-
 	*n_pages = 0;
 
-	while ((rec = ibuf_get_user_rec(pcur, mtr)) != 0
-	       && ibuf_rec_get_space(mtr, rec) == space
-	       && *n_pages < limit) {
+	while ((rec = ibuf_get_user_rec(pcur, mtr)) != 0) {
+		ulint	rec_space = ibuf_rec_get_space(mtr, rec);
+
+		if (space != ULINT_UNDEFINED
+		    && (rec_space != space || *n_pages == limit)) {
+			break;
+		}
 
 		ulint	page_no = ibuf_rec_get_page_no(mtr, rec);
 
-		if (*n_pages == 0 || pages[*n_pages - 1] != page_no) {
-			spaces[*n_pages] = space;
+		if (*n_pages == 0 || pages[*n_pages - 1] != page_no
+		    || spaces[*n_pages - 1] != rec_space) {
+			if (*n_pages == limit) {
+				/* Across tablespaces, stop only after all
+				records of the last page were counted. */
+				break;
+			}
+
+			spaces[*n_pages] = rec_space;
 			pages[*n_pages] = page_no;
 			++*n_pages;
 		}
@@ -2591,6 +2601,126 @@ ulint ibuf_merge_all()
 	return sum_bytes;
 }
 
+/** Background change buffer merge */
+static std::unique_ptr<tpool::timer> ibuf_merge_timer;
+
+/** The (space, page) key from which the next background merge
+round will continue its scan of the change buffer tree. Only
+accessed by ibuf_merge_callback(), which never runs concurrently
+with itself. */
+static ulint ibuf_merge_next_space, ibuf_merge_next_page;
+
+/** Merge buffered changes to some pages in key order, starting from
+ibuf_merge_next_space, ibuf_merge_next_page.
+@param[in]	limit	maximum number of pages to merge
+@return number of pages merged, or 0 if the end of the tree was reached */
+static ulint ibuf_merge_in_order(ulint limit)
+{
+	mtr_t		mtr;
+	btr_pcur_t	pcur;
+	mem_heap_t*	heap = mem_heap_create(512);
+	ulint		pages[IBUF_MAX_N_PAGES_MERGED];
+	ulint		spaces[IBUF_MAX_N_PAGES_MERGED];
+	ulint		n_pages = 0;
+
+	ibuf_mtr_start(&mtr);
+
+	btr_pcur_open(ibuf.index,
+		      ibuf_search_tuple_build(ibuf_merge_next_space,
+					      ibuf_merge_next_page, heap),
+		      PAGE_CUR_GE, BTR_SEARCH_LEAF, &pcur, &mtr);
+
+	mem_heap_free(heap);
+
+	if (!page_is_empty(btr_pcur_get_page(&pcur))) {
+		ibuf_get_merge_pages(&pcur, ULINT_UNDEFINED,
+				     ut_min(limit, IBUF_MAX_N_PAGES_MERGED),
+				     pages, spaces, &n_pages, &mtr);
+	}
+
+	ibuf_mtr_commit(&mtr);
+	btr_pcur_close(&pcur);
+
+	if (!n_pages) {
+		/* Wrap around to the start of the tree. */
+		ibuf_merge_next_space = 0;
+		ibuf_merge_next_page = 0;
+		return 0;
+	}
+
+	/* Submit asynchronous reads for all the pages, so that the
+	merge below will mostly find them in (or on the way to) the
+	buffer pool instead of reading them one at a time. */
+	os_aio_batch_begin();
+
+	for (ulint i = 0; i < n_pages; ) {
+		const ulint space_id = spaces[i];
+		fil_space_t* s = fil_space_acquire_for_io(space_id);
+
+		for (; i < n_pages && spaces[i] == space_id; i++) {
+			if (s && pages[i] < s->size) {
+				buf_read_page_background(
+					page_id_t(space_id, pages[i]),
+					s->zip_size(), false);
+			}
+		}
+
+		if (s) {
+			s->release_for_io();
+		}
+	}
+
+	os_aio_batch_end();
+
+	ibuf_read_merge_pages(spaces, pages, n_pages);
+
+	ibuf_merge_next_space = spaces[n_pages - 1];
+	ibuf_merge_next_page = pages[n_pages - 1] + 1;
+	ibuf.n_background_merges += n_pages;
+
+	return n_pages;
+}
+
+/** Merge the change buffer in the background, within
+innodb_change_buffer_merge_pct of innodb_io_capacity. */
+static void ibuf_merge_callback(void*)
+{
+	const uint pct = srv_change_buffer_merge_pct;
+
+	if (!pct || ibuf.empty || srv_shutdown_state != SRV_SHUTDOWN_NONE
+	    || srv_force_recovery >= SRV_FORCE_NO_IBUF_MERGE) {
+		return;
+	}
+#if defined UNIV_DEBUG || defined UNIV_IBUF_DEBUG
+	if (ibuf_debug) {
+		return;
+	}
+#endif /* UNIV_DEBUG || UNIV_IBUF_DEBUG */
+
+	const ulint budget = ut_max<ulint>(PCT_IO(pct), 1);
+
+	for (ulint n = 0; n < budget
+	     && srv_shutdown_state == SRV_SHUTDOWN_NONE; ) {
+		ulint n_pages = ibuf_merge_in_order(budget - n);
+		if (!n_pages) {
+			break;
+		}
+		n += n_pages;
+	}
+}
+
+/** Start the background change buffer merge. */
+void ibuf_merge_start()
+{
+	srv_start_periodic_timer(ibuf_merge_timer, ibuf_merge_callback, 1000);
+}
+
+/** Stop the background change buffer merge. */
+void ibuf_merge_shutdown()
+{
+	ibuf_merge_timer.reset();
+}
+
 /*********************************************************************//**
 Contract insert buffer trees after insert if they are too big. */
 UNIV_INLINE
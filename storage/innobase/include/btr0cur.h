@@ -614,6 +614,12 @@ btr_estimate_n_rows_in_range(
 	const dtuple_t*	tuple2,
 	page_cur_mode_t	mode2);
 
+/** Read ahead the leaf page of an index tree on which a search for a
+tuple would end up, without waiting for the read to complete.
+@param[in]	index	B-tree index
+@param[in]	tuple	search tuple */
+void btr_cur_prefetch_leaf(dict_index_t* index, const dtuple_t* tuple);
+
 /*******************************************************************//**
 Estimates the number of different key values in a given index, for
 each n-column prefix of the index where 1 <= n <= dict_index_get_n_unique(index).
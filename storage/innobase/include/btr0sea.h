@@ -236,6 +236,13 @@ struct btr_search_t{
 				which would have succeeded, or did succeed,
 				using the hash index;
 				the range is 0 .. BTR_SEARCH_BUILD_LIMIT + 5 */
+	ulint	n_lookups;	/*!< number of hash index lookups since
+				the hit ratio was last evaluated */
+	ulint	n_lookup_hits;	/*!< number of successful lookups among
+				n_lookups */
+	ulint	n_disabled;	/*!< if nonzero, the hash index is not
+				used on this index for this many searches,
+				because too few lookups succeeded */
 	/* @} */
 	ulint	ref_count;	/*!< Number of blocks in this index tree
 				that have search index built
@@ -285,6 +292,13 @@ extern rw_lock_t**		btr_search_latches;
 /** The adaptive hash index */
 extern btr_search_sys_t*	btr_search_sys;
 
+/** Number of times the hash index was suspended on an index,
+because too few lookups succeeded */
+extern Atomic_counter<ulint>	btr_search_n_index_disabled;
+/** Number of searches without btr_search_latches that had to be
+repeated while holding the latch */
+extern Atomic_counter<ulint>	btr_search_n_unlatched_retries;
+
 #ifdef UNIV_SEARCH_PERF_STAT
 /** Number of successful adaptive hash index lookups */
 extern ulint	btr_search_n_succ;
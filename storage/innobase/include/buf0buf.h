@@ -80,6 +80,9 @@ struct fil_addr_t;
 					buffer pool watches */
 #define MAX_PAGE_HASH_LOCKS	1024	/*!< The maximum number of
 					page_hash locks */
+#define BUF_PAGE_HASH_PAGES_PER_LOCK 256
+					/*!< Number of pages per page_hash
+					lock when innodb_page_hash_locks=0 */
 
 extern	buf_pool_t*	buf_pool_ptr;	/*!< The buffer pools
 					of the database */
@@ -1084,6 +1087,7 @@ if applicable. */
 #ifdef BTR_CUR_HASH_ADAPT
 /** Get a buffer block from an adaptive hash index pointer.
 This function does not return if the block is not identified.
+The state of the block is not checked.
 @param[in]	ptr	pointer to within a page frame
 @return pointer to block, never NULL */
 buf_block_t*
@@ -121,19 +121,41 @@ buf_dblwr_write_single_page(
 	buf_page_t*	bpage,	/*!< in: buffer block to write */
 	bool		sync);	/*!< in: true if sync IO requested */
 
+/** A segment of the doublewrite buffer for batch flushing. Each segment
+is written to its own doublewrite block, so that pages can be collected
+and written to one segment while the data file writes of the pages of
+another segment are still in progress. */
+struct buf_dblwr_seg_t{
+	ulint		start;	/*!< first slot of the segment in
+				write_buf and buf_block_arr */
+	ulint		page_no;/*!< page number of the first page of
+				the segment in the system tablespace */
+	ulint		first_free;/*!< number of pages in the segment */
+	ulint		reserved;/*!< number of pages of the segment
+				whose data file write has not completed */
+	bool		flushing;/*!< whether the segment has been
+				written to the doublewrite buffer and
+				its pages are being written to the
+				data files; no pages can be added to the
+				segment until this is reset */
+};
+
 /** Doublewrite control struct */
 struct buf_dblwr_t{
-	ib_mutex_t	mutex;	/*!< mutex protecting the first_free
-				field and write_buf */
+	ib_mutex_t	mutex;	/*!< mutex protecting the segments,
+				write_buf and buf_block_arr */
 	ulint		block1;	/*!< the page number of the first
 				doublewrite block (64 pages) */
 	ulint		block2;	/*!< page number of the second block */
-	ulint		first_free;/*!< first free position in write_buf
-				measured in units of srv_page_size */
-	ulint		b_reserved;/*!< number of slots currently reserved
-				for batch flush. */
-	os_event_t	b_event;/*!< event where threads wait for a
-				batch flush to end;
+	buf_dblwr_seg_t	seg[2];	/*!< batch flushing segments,
+				in block1 and block2 */
+	ulint		active;	/*!< index of the segment in seg[]
+				that pages are being added to */
+	ulint		seg_size;/*!< number of pages in a segment;
+				the rest of each doublewrite block is
+				used for single page flushes */
+	os_event_t	b_event;/*!< event where threads wait for the
+				flush of a segment to end;
 				os_event_set() and os_event_reset()
 				are protected by buf_dblwr_t::mutex */
 	ulint		s_reserved;/*!< number of slots currently
@@ -143,9 +165,6 @@ struct buf_dblwr_t{
 	bool*		in_use;	/*!< flag used to indicate if a slot is
 				in use. Only used for single page
 				flushes. */
-	bool		batch_running;/*!< set to TRUE if currently a batch
-				is being written from the doublewrite
-				buffer. */
 	byte*		write_buf;/*!< write buffer used in writing to the
 				doublewrite buffer, aligned to an
 				address divisible by srv_page_size
@@ -100,6 +100,19 @@ which could result in a deadlock if the OS does not support asynchronous io.
 ulint
 buf_read_ahead_linear(const page_id_t page_id, ulint zip_size, bool ibuf);
 
+/** Issue asynchronous read requests for leaf pages that an index range
+scan is about to access in key order. Unlike buf_read_ahead_linear(),
+this does not depend on the physical placement of the pages.
+NOTE: the calling thread must not hold any page latches.
+@param[in]	space_id	tablespace identifier
+@param[in]	zip_size	ROW_FORMAT=COMPRESSED page size, or 0
+@param[in]	page_nos	page numbers to read, in key order
+@param[in]	n		number of elements in page_nos
+@return number of page read requests issued */
+ulint
+buf_read_ahead_logical(ulint space_id, ulint zip_size,
+		       const uint32_t* page_nos, ulint n);
+
 /** Issues read requests for pages which recovery wants to read in.
 @param[in]	sync		true if the caller wants this function to wait
 for the highest address page to get read in, before this function returns
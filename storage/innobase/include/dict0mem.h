@@ -2226,7 +2226,7 @@ struct dict_table_t {
 	ulong					n_waiting_or_granted_auto_inc_locks;
 
 	/** The transaction that currently holds the the AUTOINC lock on this
-	table. Protected by lock_sys.mutex. */
+	table. Protected by lock_sys.latch. */
 	const trx_t*				autoinc_trx;
 
 	/* @} */
@@ -2241,8 +2241,8 @@ struct dict_table_t {
 
 	/** Count of the number of record locks on this table. We use this to
 	determine whether we can evict the table from the dictionary cache.
-	It is protected by lock_sys.mutex. */
-	ulint					n_rec_locks;
+	Modified while holding lock_sys.latch in any mode. */
+	Atomic_counter<ulint>			n_rec_locks;
 
 private:
 	/** Count of how many handles are opened to this table. Dropping of the
@@ -2251,7 +2251,9 @@ struct dict_table_t {
 	Atomic_counter<uint32_t>		n_ref_count;
 
 public:
-	/** List of locks on the table. Protected by lock_sys.mutex. */
+	/** List of locks on the table. Protected by lock_sys.latch,
+	or by lock_sys.latch in shared mode together with
+	lock_sys.table_latch(). */
 	table_lock_list_t			locks;
 
 	/** Timestamp of the last modification of this table. */
@@ -43,6 +43,30 @@ ha_search_and_get_data(
 /*===================*/
 	hash_table_t*	table,	/*!< in: hash table */
 	ulint		fold);	/*!< in: folded value of the searched data */
+
+/** Look for an element in the adaptive hash index without holding the
+latch. The result is only valid if ha_search_unlatched_valid() holds.
+@param[in]	table		hash table
+@param[in]	fold		folded value of the searched data
+@param[out]	n_modified	modification count to pass to
+				ha_search_unlatched_valid()
+@return pointer to the data of the first hash table node in chain
+having the fold number, NULL if not found */
+inline const rec_t*
+ha_search_and_get_data_unlatched(
+	hash_table_t*	table,
+	ulint		fold,
+	ulint*		n_modified);
+
+/** Check that the adaptive hash index was not modified since
+ha_search_and_get_data_unlatched().
+@param[in]	table		hash table
+@param[in]	n_modified	modification count returned by
+				ha_search_and_get_data_unlatched()
+@return whether the result of the search is valid */
+inline bool
+ha_search_unlatched_valid(const hash_table_t* table, ulint n_modified);
+
 /*********************************************************//**
 Looks for an element when we know the pointer to the data and updates
 the pointer to data if found.
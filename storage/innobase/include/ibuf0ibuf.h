@@ -353,6 +353,12 @@ will be merged from ibuf trees to the pages read, 0 if ibuf is
 empty */
 ulint ibuf_merge_all();
 
+/** Start the background change buffer merge. */
+void ibuf_merge_start();
+
+/** Stop the background change buffer merge. */
+void ibuf_merge_shutdown();
+
 /** Contracts insert buffer trees by reading pages referring to space_id
 to the buffer pool.
 @returns number of pages merged.*/
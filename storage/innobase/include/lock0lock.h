@@ -579,7 +579,7 @@ lock_print_info_all_transactions(
 Return approximate number or record locks (bits set in the bitmap) for
 this transaction. Since delete-marked records may be removed, the
 record count will not be precise.
-The caller must be holding lock_sys.mutex. */
+The caller must be holding lock_sys.latch. */
 ulint
 lock_number_of_rows_locked(
 /*=======================*/
@@ -588,7 +588,7 @@ lock_number_of_rows_locked(
 
 /*********************************************************************//**
 Return the number of table locks for a transaction.
-The caller must be holding lock_sys.mutex. */
+The caller must be holding lock_sys.latch. */
 ulint
 lock_number_of_tables_locked(
 /*=========================*/
@@ -755,11 +755,18 @@ class lock_sys_t
   bool m_initialised;
 
 public:
+	/** Latch protecting the locks. Exclusive mode is needed for
+	anything but the acquisition of an uncontended record lock
+	and the release of record locks and IS or IX table locks that
+	nobody is waiting for; those only hold it in shared mode, along
+	with the latch of the rec_hash partition of the page or the
+	table_latch() of the table. */
 	MY_ALIGNED(CACHE_LINE_SIZE)
-	LockMutex	mutex;			/*!< Mutex protecting the
-						locks */
+	rw_lock_t	latch;
 	hash_table_t*	rec_hash;		/*!< hash table of the record
-						locks */
+						locks; partitioned by
+						LOCK_REC_HASH_PARTITIONS
+						rw_locks */
 	hash_table_t*	prdt_hash;		/*!< hash table of the predicate
 						lock */
 	hash_table_t*	prdt_page_hash;		/*!< hash table of the page
@@ -787,6 +794,13 @@ class lock_sys_t
 	std::unique_ptr<tpool::timer>	timeout_timer; /*!< Thread pool timer task */
 	bool timeout_timer_active;
 
+	/** number of lock_release() that did not need latch
+	in exclusive mode */
+	Atomic_counter<ulint>	n_release_shared;
+	/** number of lock_release() that acquired latch
+	in exclusive mode */
+	Atomic_counter<ulint>	n_release_exclusive;
+
 
   /**
     Constructor.
@@ -818,8 +832,54 @@ class lock_sys_t
 
   /** Closes the lock system at database shutdown. */
   void close();
+
+
+  /**
+    Get the latch of a rec_hash partition.
+
+    @param[in] fold lock_rec_fold() of the page
+    @return the latch protecting the record locks of the page
+  */
+  rw_lock_t *rec_hash_latch(ulint fold) const
+  {
+    return hash_get_lock(rec_hash, fold);
+  }
+
+  /**
+    Get the latch that protects the lock queue of a table
+    while latch is being held in shared mode. The rec_hash
+    partition latches are reused for this; no thread holds
+    more than one of them at a time.
+
+    @param[in] table table
+    @return the latch protecting table->locks
+  */
+  rw_lock_t *table_latch(const dict_table_t *table) const
+  {
+    return hash_get_lock(rec_hash, ut_fold_ull(table->id));
+  }
+
+#ifdef UNIV_DEBUG
+  /**
+    Check if the record locks of a page may be accessed.
+
+    @param[in] hash rec_hash, prdt_hash or prdt_page_hash
+    @param[in] fold lock_rec_fold() of the page
+    @return whether the current thread holds latch in exclusive mode,
+    or in shared mode along with the rec_hash partition of the page
+  */
+  bool page_latched(const hash_table_t *hash, ulint fold)
+  {
+    return rw_lock_own(&latch, RW_LOCK_X) ||
+      (hash == rec_hash && rw_lock_own(&latch, RW_LOCK_S) &&
+       rw_lock_own(rec_hash_latch(fold), RW_LOCK_X));
+  }
+#endif /* UNIV_DEBUG */
 };
 
+/** Number of latches protecting lock_sys.rec_hash */
+#define LOCK_REC_HASH_PARTITIONS	256
+
 /*********************************************************************//**
 Creates a new record lock and inserts it to the lock queue. Does NOT check
 for deadlocks or lock compatibility!
@@ -933,21 +993,22 @@ lock_rec_free_all_from_discard_page(
 /** The lock system */
 extern lock_sys_t lock_sys;
 
-/** Test if lock_sys.mutex can be acquired without waiting. */
+/** Try to acquire lock_sys.latch in exclusive mode without waiting.
+@return 0 if the latch was acquired */
 #define lock_mutex_enter_nowait() 		\
-	(lock_sys.mutex.trylock(__FILE__, __LINE__))
+	(!rw_lock_x_lock_nowait(&lock_sys.latch))
 
-/** Test if lock_sys.mutex is owned. */
-#define lock_mutex_own() (lock_sys.mutex.is_owned())
+/** Test if lock_sys.latch is owned in exclusive mode. */
+#define lock_mutex_own() rw_lock_own(&lock_sys.latch, RW_LOCK_X)
 
-/** Acquire the lock_sys.mutex. */
+/** Acquire lock_sys.latch in exclusive mode. */
 #define lock_mutex_enter() do {			\
-	mutex_enter(&lock_sys.mutex);		\
+	rw_lock_x_lock(&lock_sys.latch);	\
 } while (0)
 
-/** Release the lock_sys.mutex. */
+/** Release lock_sys.latch from exclusive mode. */
 #define lock_mutex_exit() do {			\
-	lock_sys.mutex.exit();			\
+	rw_lock_x_unlock(&lock_sys.latch);	\
 } while (0)
 
 /** Test if lock_sys.wait_mutex is owned. */
@@ -107,8 +107,16 @@ log mutex. */
 void
 log_write_low(
 /*==========*/
-	const byte*	str,		/*!< in: string */
+	const byte*	str,		/*!< in: string, or NULL to only
+					reserve space for log_copy_low() */
 	ulint		str_len);	/*!< in: string length */
+/** Copy a string to log buffer space that was reserved by
+log_write_low(NULL, len). The caller must not hold the log mutex,
+but it must have incremented log_sys.n_pending_copies while holding it.
+@param[in,out]	ptr	position in log_sys.buf; advanced past the string
+@param[in]	str	string
+@param[in]	len	string length */
+void log_copy_low(byte*& ptr, const byte* str, ulint len);
 /************************************************************//**
 Closes the log.
 @return lsn */
@@ -484,6 +492,9 @@ struct log_t{
 	lsn_t		lsn;		/*!< log sequence number */
 	ulong		buf_free;	/*!< first free offset within the log
 					buffer in use */
+	/** number of mtr_t::commit() that are copying log records to
+	space in buf that they reserved while holding mutex */
+	std::atomic<size_t>	n_pending_copies;
 
 	MY_ALIGNED(CACHE_LINE_SIZE)
 	LogSysMutex	mutex;		/*!< mutex protecting the log */
@@ -730,6 +741,23 @@ struct log_t{
       : OS_FILE_LOG_BLOCK_SIZE - LOG_BLOCK_CHECKSUM;
   }
 
+  /** Register a copy to space in buf that was reserved while holding mutex */
+  void start_copy()
+  {
+    ut_ad(mutex_own(&mutex));
+    n_pending_copies.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /** Unregister a copy that was registered by start_copy() */
+  void finish_copy()
+  {
+    n_pending_copies.fetch_sub(1, std::memory_order_release);
+  }
+
+  /** Wait until no mtr_t::commit() is copying to buf.
+  The caller must hold mutex, so that no further space can be reserved. */
+  void wait_for_copies() const;
+
   size_t get_pending_flushes() const
   {
     return pending_flushes.load(std::memory_order_relaxed);
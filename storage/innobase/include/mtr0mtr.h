@@ -491,8 +491,12 @@ struct mtr_t {
 
 	/** Append the redo log records to the redo log buffer.
 	@param[in]	len	number of bytes to write
+	@param[out]	copy	NULL to copy the records while holding
+				log_sys.mutex; else where the caller must
+				copy them after releasing log_sys.mutex,
+				or NULL if they were already copied
 	@return start_lsn */
-	inline lsn_t finish_write(ulint len);
+	inline lsn_t finish_write(ulint len, byte** copy = NULL);
 
 	/** Release the resources */
 	inline void release_resources();
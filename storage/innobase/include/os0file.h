@@ -1415,6 +1415,24 @@ be other, synchronous, pending writes. */
 void
 os_aio_wait_until_no_pending_writes();
 
+/** Start collecting the asynchronous reads requested by the current
+thread, instead of submitting them one by one.
+The reads will be submitted by os_aio_batch_end(). */
+void os_aio_batch_begin();
+
+/** Submit the asynchronous reads collected since os_aio_batch_begin(). */
+void os_aio_batch_end();
+
+/** Register the memory areas that will be used as IO buffers
+with the asynchronous IO subsystem.
+@param[in]	bufs	start addresses of the areas
+@param[in]	lens	lengths of the areas, in bytes
+@param[in]	n	number of areas */
+void os_aio_register_buffers(void* const* bufs, const size_t* lens, size_t n);
+
+/** Forget the buffers registered by os_aio_register_buffers(). */
+void os_aio_unregister_buffers();
+
 
 /** Prints info of the aio arrays.
 @param[in/out]	file		file where to print */
@@ -418,6 +418,7 @@ row_merge_file_create(
 @param[in,out]	stage	performance schema accounting object, used by
 ALTER TABLE. If not NULL, stage->begin_phase_sort() will be called initially
 and then stage->inc() will be called for each record processed.
+@param[in]	n_threads	maximum number of threads for merging the runs
 @return DB_SUCCESS or error code */
 dberr_t
 row_merge_sort(
@@ -432,7 +433,8 @@ row_merge_sort(
 	const double	pct_cost,
 	row_merge_block_t*	crypt_block,
 	ulint			space,
-	ut_stage_alter_t*	stage = NULL)
+	ut_stage_alter_t*	stage = NULL,
+	ulint			n_threads = 1)
 	MY_ATTRIBUTE((warn_unused_result));
 
 /*********************************************************************//**
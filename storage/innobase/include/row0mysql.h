@@ -562,7 +562,10 @@ struct mysql_row_templ_t {
 	ulint	is_virtual;		/*!< if a column is a virtual column */
 };
 
+/* Initial number of rows to fetch in a batch to fetch_cache */
 #define MYSQL_FETCH_CACHE_SIZE		8
+/* Maximum number of rows to fetch in a batch to fetch_cache */
+#define MYSQL_FETCH_CACHE_MAX		128
 /* After fetching this many rows, we start caching them in fetch_cache */
 #define MYSQL_FETCH_CACHE_THRESHOLD	4
 
@@ -737,7 +740,7 @@ struct row_prebuilt_t {
 	ulint		n_rows_fetched;	/*!< number of rows fetched after
 					positioning the current cursor */
 	ulint		fetch_direction;/*!< ROW_SEL_NEXT or ROW_SEL_PREV */
-	byte*		fetch_cache[MYSQL_FETCH_CACHE_SIZE];
+	byte*		fetch_cache[MYSQL_FETCH_CACHE_MAX];
 					/*!< a cache for fetched rows if we
 					fetch many rows from the same cursor:
 					it saves CPU time to fetch them in a
@@ -747,6 +750,20 @@ struct row_prebuilt_t {
 					allocated mem buf start, because
 					there is a 4 byte magic number at the
 					start and at the end */
+	ulint		fetch_cache_alloc;/*!< number of allocated
+					elements of fetch_cache */
+	ulint		fetch_cache_limit;/*!< number of rows to fetch
+					in the current batch; this grows
+					with n_rows_fetched, up to a page
+					worth of rows */
+	ulint		n_read_ahead;	/*!< number of leaf pages requested
+					by innodb_logical_read_ahead that the
+					cursor has not reached yet; at the
+					start of a scan, this also counts the
+					leaf pages to pass before the first
+					read-ahead */
+	uint32_t	read_ahead_page_no;/*!< the leaf page of the cursor
+					when n_read_ahead was last updated */
 	bool		keep_other_fields_on_keyread; /*!< when using fetch
 					cache with HA_EXTRA_KEYREAD, don't
 					overwrite other fields in mysql row
@@ -35,6 +35,7 @@ Created 3/14/1997 Heikki Tuuri
 #include "row0mysql.h"
 #include "mysqld.h"
 #include <queue>
+#include <vector>
 
 class MDL_ticket;
 /** Determines if it is possible to remove a secondary index entry.
@@ -152,6 +153,22 @@ struct purge_node_t{
 	/** Undo recs to purge */
 	std::queue<trx_purge_rec_t>	undo_recs;
 
+	/** Leaf page of the latest purged secondary index record */
+	struct sec_leaf_t {
+		/** secondary index of table */
+		const dict_index_t*	index;
+		/** the leaf page */
+		buf_block_t*		block;
+		/** block->modify_clock after the purge */
+		ib_uint64_t		modify_clock;
+		/** buf_withdraw_clock after the purge */
+		ulint			withdraw_clock;
+	};
+
+	/** Hints for row_purge_remove_sec_if_poss_leaf(), at most one
+	per secondary index of table */
+	std::vector<sec_leaf_t>		sec_leaves;
+
 	/** Constructor */
 	explicit purge_node_t(que_thr_t* parent) :
 		common(QUE_NODE_PURGE, parent),
@@ -215,10 +232,24 @@ struct purge_node_t{
   }
 
 
+  /** Look up the leaf page hint of a secondary index.
+  @param index  secondary index of table
+  @return the hint
+  @retval nullptr if there is none */
+  sec_leaf_t *sec_leaf(const dict_index_t *index)
+  {
+    for (sec_leaf_t &leaf : sec_leaves)
+      if (leaf.index == index)
+        return &leaf;
+    return nullptr;
+  }
+
+
   /** Close the existing table and release the MDL for it. */
   void close_table()
   {
     last_table_id= 0;
+    sec_leaves.clear();
     if (!table)
     {
       ut_ad(!mdl_ticket);
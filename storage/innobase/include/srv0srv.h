@@ -256,6 +256,9 @@ extern	ulong	srv_adaptive_max_sleep_delay;
 
 /** Sort buffer size in index creation */
 extern ulong	srv_sort_buf_size;
+/** innodb_merge_sort_threads; number of threads for merging the sorted
+runs in index creation */
+extern ulong	srv_merge_sort_threads;
 /** Maximum modification log file size for online index creation */
 extern unsigned long long	srv_online_max_size;
 
@@ -264,6 +267,10 @@ OS (provided we compiled Innobase with it in), otherwise we will
 use simulated aio.
 Currently we support native aio on windows and linux */
 extern my_bool	srv_use_native_aio;
+#ifdef __linux__
+/** innodb_linux_aio: native AIO implementation on Linux */
+extern ulong	srv_linux_aio;
+#endif
 extern my_bool	srv_numa_interleave;
 
 /* Use atomic writes i.e disable doublewrite buffer */
@@ -385,6 +392,7 @@ extern ulint	srv_lock_table_size;
 extern ulint	srv_n_file_io_threads;
 extern my_bool	srv_random_read_ahead;
 extern ulong	srv_read_ahead_threshold;
+extern ulong	srv_logical_read_ahead;
 extern ulong	srv_n_read_io_threads;
 extern ulong	srv_n_write_io_threads;
 
@@ -401,6 +409,7 @@ extern ulonglong	srv_defragment_interval;
 extern ulong	srv_idle_flush_pct;
 
 extern uint	srv_change_buffer_max_size;
+extern uint	srv_change_buffer_merge_pct;
 
 /* Number of IO operations per second the server can do */
 extern ulong    srv_io_capacity;
@@ -428,9 +437,14 @@ extern double	srv_max_dirty_pages_pct;
 extern double	srv_max_dirty_pages_pct_lwm;
 
 extern double	srv_adaptive_flushing_lwm;
+extern double	srv_adaptive_flushing_target;
 extern ulong	srv_flushing_avg_loops;
 
 extern ulong	srv_force_recovery;
+/** innodb_recovery_apply_tasks: number of tpool tasks that apply
+buffered redo log to pages in the buffer pool; 0=apply in the
+recovery thread */
+extern ulong	srv_recovery_apply_tasks;
 
 extern uint	srv_fast_shutdown;	/*!< If this is 1, do not do a
 					purge and index buffer merge.
@@ -63,6 +63,10 @@ IF(UNIX)
       ADD_DEFINITIONS(-DLINUX_NATIVE_AIO=1)
       LINK_LIBRARIES(aio)
     ENDIF()
+    # The checks are done in tpool/CMakeLists.txt
+    IF(WITH_URING AND HAVE_LIBURING_H AND HAVE_LIBURING)
+      ADD_DEFINITIONS(-DHAVE_URING=1)
+    ENDIF()
     IF(HAVE_LIBNUMA)
       LINK_LIBRARIES(numa)
     ENDIF()
@@ -42,6 +42,7 @@ Created 5/7/1996 Heikki Tuuri
 #include "row0mysql.h"
 #include "row0vers.h"
 #include "pars0pars.h"
+#include "sync0sync.h"
 
 #include <set>
 
@@ -251,7 +252,7 @@ class DeadlockChecker {
 		ulint		m_heap_no;	/*!< heap number if rec lock */
 	};
 
-	/** Used in deadlock tracking. Protected by lock_sys.mutex. */
+	/** Used in deadlock tracking. Protected by lock_sys.latch. */
 	static ib_uint64_t	s_lock_mark_counter;
 
 	/** Calculation steps thus far. It is the count of the nodes visited. */
@@ -457,12 +458,15 @@ void lock_sys_t::create(ulint n_cells)
 		(ut_zalloc_nokey(srv_max_n_threads * sizeof *waiting_threads));
 	last_slot = waiting_threads;
 
-	mutex_create(LATCH_ID_LOCK_SYS, &mutex);
+	rw_lock_create(lock_sys_latch_key, &latch, SYNC_LOCK_SYS);
 
 	mutex_create(LATCH_ID_LOCK_SYS_WAIT, &wait_mutex);
 
 
 	rec_hash = hash_create(n_cells);
+	hash_create_sync_obj(rec_hash, HASH_TABLE_SYNC_RW_LOCK,
+			     LATCH_ID_LOCK_SYS_REC_HASH,
+			     LOCK_REC_HASH_PARTITIONS);
 	prdt_hash = hash_create(n_cells);
 	prdt_page_hash = hash_create(n_cells);
 
@@ -495,10 +499,15 @@ void lock_sys_t::resize(ulint n_cells)
 {
 	ut_ad(this == &lock_sys);
 
-	mutex_enter(&mutex);
+	lock_mutex_enter();
 
 	hash_table_t* old_hash = rec_hash;
 	rec_hash = hash_create(n_cells);
+	/* The partition latches are not being held by anyone,
+	because we hold the exclusive latch. */
+	rec_hash->type = old_hash->type;
+	rec_hash->n_sync_obj = old_hash->n_sync_obj;
+	rec_hash->sync_obj = old_hash->sync_obj;
 	HASH_MIGRATE(old_hash, rec_hash, lock_t, hash,
 		     lock_rec_lock_fold);
 	hash_table_free(old_hash);
@@ -540,7 +549,7 @@ void lock_sys_t::resize(ulint n_cells)
 		buf_pool_mutex_exit(buf_pool);
 	}
 
-	mutex_exit(&mutex);
+	lock_mutex_exit();
 }
 
 
@@ -556,11 +565,16 @@ void lock_sys_t::close()
 		lock_latest_err_file = NULL;
 	}
 
+	for (ulint i = 0; i < rec_hash->n_sync_obj; i++) {
+		rw_lock_free(hash_get_nth_lock(rec_hash, i));
+	}
+
+	ut_free(rec_hash->sync_obj.rw_locks);
 	hash_table_free(rec_hash);
 	hash_table_free(prdt_hash);
 	hash_table_free(prdt_page_hash);
 
-	mutex_destroy(&mutex);
+	rw_lock_free(&latch);
 	mutex_destroy(&wait_mutex);
 
 	for (ulint i = srv_max_n_threads; i--; ) {
@@ -1240,7 +1254,7 @@ lock_sec_rec_some_has_impl(
 Return approximate number or record locks (bits set in the bitmap) for
 this transaction. Since delete-marked records may be removed, the
 record count will not be precise.
-The caller must be holding lock_sys.mutex. */
+The caller must be holding lock_sys.latch. */
 ulint
 lock_number_of_rows_locked(
 /*=======================*/
@@ -1253,7 +1267,7 @@ lock_number_of_rows_locked(
 
 /*********************************************************************//**
 Return the number of table locks for a transaction.
-The caller must be holding lock_sys.mutex. */
+The caller must be holding lock_sys.latch. */
 ulint
 lock_number_of_tables_locked(
 /*=========================*/
@@ -1338,7 +1352,8 @@ lock_rec_create_low(
 	ulint		n_bits;
 	ulint		n_bytes;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_sys.page_latched(lock_hash_get(type_mode),
+				    lock_rec_fold(space, page_no)));
 	ut_ad(holds_trx_mutex == trx_mutex_own(trx));
 	ut_ad(dict_index_is_clust(index) || !dict_index_is_online_ddl(index));
 
@@ -1500,8 +1515,8 @@ lock_rec_create_low(
 	if (!holds_trx_mutex) {
 		trx_mutex_exit(trx);
 	}
-	MONITOR_INC(MONITOR_RECLOCK_CREATED);
-	MONITOR_INC(MONITOR_NUM_RECLOCK);
+	MONITOR_ATOMIC_INC(MONITOR_RECLOCK_CREATED);
+	MONITOR_ATOMIC_INC(MONITOR_NUM_RECLOCK);
 
 	return lock;
 }
@@ -1899,6 +1914,63 @@ lock_rec_add_to_queue(
 		type_mode, block, heap_no, index, trx, caller_owns_trx_mutex);
 }
 
+/** Try to lock a record while holding lock_sys.latch in shared mode.
+This covers the common cases where no other transaction holds locks
+on the page, so that transactions that access different pages do not
+have to wait for each other.
+@param[in]	impl	if true, no lock is set if no wait is necessary
+@param[in]	mode	lock mode: LOCK_X or LOCK_S possibly ORed to either
+			LOCK_GAP or LOCK_REC_NOT_GAP
+@param[in]	block	buffer block containing the record
+@param[in]	heap_no	heap number of the record
+@param[in]	index	index of the record
+@param[in,out]	trx	transaction
+@param[out]	err	DB_SUCCESS or DB_SUCCESS_LOCKED_REC
+@return whether the request was handled; if not, it must be retried
+while holding lock_sys.latch in exclusive mode */
+static bool lock_rec_lock_try(bool impl, ulint mode, const buf_block_t *block,
+                              ulint heap_no, dict_index_t *index, trx_t *trx,
+                              dberr_t *err)
+{
+  bool done= true;
+
+  rw_lock_s_lock(&lock_sys.latch);
+  trx_mutex_enter(trx);
+  rw_lock_t *latch= lock_sys.rec_hash_latch(
+    lock_rec_fold(block->page.id.space(), block->page.id.page_no()));
+  rw_lock_x_lock(latch);
+
+  if (lock_t *lock= lock_rec_get_first_on_page(lock_sys.rec_hash, block))
+  {
+    if (lock_rec_get_next_on_page(lock) ||
+        lock->trx != trx ||
+        lock->type_mode != (ulint(mode) | LOCK_REC) ||
+        lock_rec_get_n_bits(lock) <= heap_no)
+      done= false;
+    else if (!impl && !lock_rec_get_nth_bit(lock, heap_no))
+    {
+      lock_rec_set_nth_bit(lock, heap_no);
+      *err= DB_SUCCESS_LOCKED_REC;
+    }
+  }
+  else
+  {
+    if (!impl)
+      lock_rec_create(
+#ifdef WITH_WSREP
+        NULL, NULL,
+#endif
+        mode, block, heap_no, index, trx, true);
+
+    *err= DB_SUCCESS_LOCKED_REC;
+  }
+
+  rw_lock_x_unlock(latch);
+  trx_mutex_exit(trx);
+  rw_lock_s_unlock(&lock_sys.latch);
+  return done;
+}
+
 /*********************************************************************//**
 Tries to lock the specified record in the mode requested. If not immediately
 possible, enqueues a waiting lock request. This is a low-level function
@@ -1935,6 +2007,12 @@ lock_rec_lock(
   ut_ad(dict_index_is_clust(index) || !dict_index_is_online_ddl(index));
   DBUG_EXECUTE_IF("innodb_report_deadlock", return DB_DEADLOCK;);
 
+  if (lock_rec_lock_try(impl, mode, block, heap_no, index, trx, &err))
+  {
+    MONITOR_ATOMIC_INC(MONITOR_NUM_RECLOCK_REQ);
+    return err;
+  }
+
   lock_mutex_enter();
   ut_ad((LOCK_MODE_MASK & mode) != LOCK_S ||
         lock_table_has(trx, index->table, LOCK_IS));
@@ -4266,6 +4344,110 @@ lock_check_dict_lock(
 }
 #endif /* UNIV_DEBUG */
 
+/** Release the record locks and the IS and IX table locks of a committing
+transaction that no other transaction is waiting for, while holding
+lock_sys.latch in shared mode.
+@param[in,out]	trx		committing transaction
+@param[in]	max_trx_id	trx_sys.get_max_trx_id()
+@return whether all locks of the transaction were released */
+static bool lock_release_try(trx_t *trx, trx_id_t max_trx_id)
+{
+  rw_lock_s_lock(&lock_sys.latch);
+  trx_mutex_enter(trx);
+
+  /* Large transactions are better served by lock_release(), which
+  lets other threads access the lock system every now and then. */
+  if (UT_LIST_GET_LEN(trx->lock.trx_locks) <= LOCK_RELEASE_INTERVAL)
+  {
+    bool rec_locks_left= false;
+    lock_t *prev;
+    for (lock_t *lock= UT_LIST_GET_LAST(trx->lock.trx_locks); lock;
+         lock= prev)
+    {
+      prev= UT_LIST_GET_PREV(trx_locks, lock);
+
+      if (lock_get_type_low(lock) != LOCK_REC)
+        continue;
+
+      if (lock_hash_get(lock->type_mode) != lock_sys.rec_hash)
+      {
+        rec_locks_left= true;
+        continue;
+      }
+
+      const ulint space= lock->un_member.rec_lock.space;
+      const ulint page_no= lock->un_member.rec_lock.page_no;
+      const ulint fold= lock_rec_fold(space, page_no);
+      rw_lock_t *latch= lock_sys.rec_hash_latch(fold);
+      rw_lock_x_lock(latch);
+
+      /* Granting waiting locks requires the exclusive latch. */
+      const lock_t *l= lock_rec_get_first_on_page_addr(lock_sys.rec_hash,
+                                                       space, page_no);
+      while (l && !lock_get_wait(l))
+        l= lock_rec_get_next_on_page_const(l);
+
+      if (!l)
+      {
+        lock->index->table->n_rec_locks--;
+        HASH_DELETE(lock_t, hash, lock_sys.rec_hash, fold, lock);
+        UT_LIST_REMOVE(trx->lock.trx_locks, lock);
+        MONITOR_ATOMIC_INC(MONITOR_RECLOCK_REMOVED);
+        MONITOR_ATOMIC_DEC(MONITOR_NUM_RECLOCK);
+      }
+      else
+        rec_locks_left= true;
+
+      rw_lock_x_unlock(latch);
+    }
+
+    /* Keep the table locks as long as any record locks remain, like
+    lock_release() which releases the locks in the reverse order of
+    their acquisition. */
+    for (lock_t *lock= rec_locks_left
+           ? NULL : UT_LIST_GET_LAST(trx->lock.trx_locks);
+         lock; lock= prev)
+    {
+      prev= UT_LIST_GET_PREV(trx_locks, lock);
+      ut_ad(lock_get_type_low(lock) & LOCK_TABLE);
+      ut_d(lock_check_dict_lock(lock));
+
+      const ulint mode= lock_get_mode(lock);
+      if (mode != LOCK_IS && mode != LOCK_IX)
+        continue;
+
+      dict_table_t *table= lock->un_member.tab_lock.table;
+      rw_lock_t *latch= lock_sys.table_latch(table);
+      rw_lock_x_lock(latch);
+
+      /* Waiting locks are only enqueued while holding the exclusive
+      lock_sys.latch, and granting them requires it too. */
+      const lock_t *l= UT_LIST_GET_FIRST(table->locks);
+      while (l && !lock_get_wait(l))
+        l= UT_LIST_GET_NEXT(un_member.tab_lock.locks, l);
+
+      if (!l)
+      {
+        if (mode == LOCK_IX && trx->undo_no)
+          /* The trx may have modified the table. We block the use of
+          the MySQL query cache for all currently active transactions. */
+          table->query_cache_inv_trx_id= max_trx_id;
+        UT_LIST_REMOVE(trx->lock.trx_locks, lock);
+        ut_list_remove(table->locks, lock, TableLockGetNode());
+        MONITOR_ATOMIC_INC(MONITOR_TABLELOCK_REMOVED);
+        MONITOR_ATOMIC_DEC(MONITOR_NUM_TABLELOCK);
+      }
+
+      rw_lock_x_unlock(latch);
+    }
+  }
+
+  const bool released= !UT_LIST_GET_LEN(trx->lock.trx_locks);
+  trx_mutex_exit(trx);
+  rw_lock_s_unlock(&lock_sys.latch);
+  return released;
+}
+
 /** Release the explicit locks of a committing transaction,
 and release possible other transactions waiting because of these locks. */
 void lock_release(trx_t* trx)
@@ -4273,9 +4455,16 @@ void lock_release(trx_t* trx)
 	ulint		count = 0;
 	trx_id_t	max_trx_id = trx_sys.get_max_trx_id();
 
-	lock_mutex_enter();
 	ut_ad(!trx_mutex_own(trx));
 
+	if (lock_release_try(trx, max_trx_id)) {
+		lock_sys.n_release_shared++;
+		return;
+	}
+
+	lock_sys.n_release_exclusive++;
+	lock_mutex_enter();
+
 	for (lock_t* lock = UT_LIST_GET_LAST(trx->lock.trx_locks);
 	     lock != NULL;
 	     lock = UT_LIST_GET_LAST(trx->lock.trx_locks)) {
@@ -4776,7 +4965,7 @@ lock_table_queue_validate(
 	     lock = UT_LIST_GET_NEXT(un_member.tab_lock.locks, lock)) {
 
 		/* lock->trx->state cannot change from or to NOT_STARTED
-		while we are holding the lock_sys.mutex. It may change
+		while we are holding the lock_sys.latch. It may change
 		from ACTIVE or PREPARED to PREPARED or COMMITTED. */
 		trx_mutex_enter(lock->trx);
 		check_trx_state(lock->trx);
@@ -46,6 +46,7 @@ Created 12/9/1995 Heikki Tuuri
 #include "dict0boot.h"
 #include "dict0stats_bg.h"
 #include "btr0defragment.h"
+#include "ibuf0ibuf.h"
 #include "srv0srv.h"
 #include "srv0start.h"
 #include "trx0sys.h"
@@ -178,6 +179,7 @@ void log_buffer_extend(ulong len)
 	const ulong old_buf_size = srv_log_buffer_size;
 	byte* old_buf = log_sys.first_in_use
 		? log_sys.buf : log_sys.buf - old_buf_size;
+	log_sys.wait_for_copies();
 	srv_log_buffer_size = new_buf_size;
 	log_sys.buf = new_buf;
 	log_sys.first_in_use = true;
@@ -337,6 +339,7 @@ log_write_low(
 	ulint	len;
 
 	ut_ad(log_mutex_own());
+	ut_ad(str || log_sys.n_pending_copies);
 	const ulint trailer_offset = log_sys.trailer_offset();
 part_loop:
 	/* Calculate a part length */
@@ -355,11 +358,13 @@ log_write_low(
 			- log_sys.buf_free % OS_FILE_LOG_BLOCK_SIZE;
 	}
 
-	memcpy_aligned<OS_FILE_LOG_BLOCK_SIZE>(log_sys.buf + log_sys.buf_free,
-					       str, len);
+	if (str) {
+		memcpy_aligned<OS_FILE_LOG_BLOCK_SIZE>(
+			log_sys.buf + log_sys.buf_free, str, len);
+		str += len;
+	}
 
 	str_len -= len;
-	str = str + len;
 
 	byte* log_block = static_cast<byte*>(
 		ut_align_down(log_sys.buf + log_sys.buf_free,
@@ -394,6 +399,54 @@ log_write_low(
 	srv_stats.log_write_requests.inc();
 }
 
+/** Copy a string to log buffer space that was reserved by
+log_write_low(NULL, len). The caller must not hold the log mutex,
+but it must have incremented log_sys.n_pending_copies while holding it.
+@param[in,out]	ptr	position in log_sys.buf; advanced past the string
+@param[in]	str	string
+@param[in]	len	string length */
+void log_copy_low(byte*& ptr, const byte* str, ulint len)
+{
+	ut_ad(log_sys.n_pending_copies);
+	const ulint trailer_offset = log_sys.trailer_offset();
+
+	while (len) {
+		const ulint offset = ut_align_offset(
+			ptr, OS_FILE_LOG_BLOCK_SIZE);
+		ut_ad(offset >= LOG_BLOCK_HDR_SIZE);
+		ut_ad(offset < trailer_offset);
+		const ulint n = std::min(len, trailer_offset - offset);
+
+		memcpy(ptr, str, n);
+		ptr += n;
+		str += n;
+		len -= n;
+
+		if (offset + n == trailer_offset) {
+			/* Skip the trailer of this block and
+			the header of the next one, which were
+			written by log_write_low(). */
+			ptr += log_sys.framing_size();
+		}
+	}
+}
+
+/** Wait until no mtr_t::commit() is copying to buf.
+The caller must hold mutex, so that no further space can be reserved. */
+void log_t::wait_for_copies() const
+{
+	ut_ad(log_mutex_own());
+
+	for (ulint i = 0;
+	     n_pending_copies.load(std::memory_order_acquire); i++) {
+		if (i < srv_n_spin_wait_rounds) {
+			ut_delay(srv_spin_wait_delay);
+		} else {
+			os_thread_yield();
+		}
+	}
+}
+
 /************************************************************//**
 Closes the log.
 @return lsn */
@@ -1033,6 +1086,10 @@ void log_write_up_to(lsn_t lsn, bool flush_to_disk, bool rotate_key)
 		}
 	}
 
+	/* Wait for the log records of the reserved space
+	to be copied, before writing out or switching the buffer. */
+	log_sys.wait_for_copies();
+
 	start_offset = log_sys.buf_next_to_write;
 	end_offset = log_sys.buf_free;
 
@@ -1589,6 +1646,7 @@ logs_empty_and_mark_files_at_shutdown(void)
 	buf_resize_shutdown();
 	dict_stats_shutdown();
 	btr_defragment_shutdown();
+	ibuf_merge_shutdown();
 
 	srv_shutdown_state = SRV_SHUTDOWN_CLEANUP;
 
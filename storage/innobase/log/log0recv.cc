@@ -2070,6 +2070,129 @@ static void recv_read_in_area(page_id_t page_id)
 	}
 }
 
+/** A part of recv_sys.pages that is processed by recv_apply_task() */
+struct recv_apply_slice_t
+{
+	/** the pages, in ascending order */
+	std::vector<page_id_t>	pages;
+	/** the task that processes the pages */
+	tpool::waitable_task*	task;
+};
+
+/** Apply the buffered log records to the pages of a recv_apply_slice_t
+that are in the buffer pool, and initiate reads for the others.
+The log records of the pages that are read will be applied by
+recv_recover_page() in the read completion callback.
+@param[in]	arg	recv_apply_slice_t */
+static void recv_apply_task(void* arg)
+{
+	const recv_apply_slice_t* slice
+		= static_cast<const recv_apply_slice_t*>(arg);
+	mtr_t mtr;
+
+	mutex_enter(&recv_sys.mutex);
+
+	for (const page_id_t page_id : slice->pages) {
+		for (;;) {
+			if (recv_sys.found_corrupt_log
+			    || recv_sys.found_corrupt_fs) {
+				goto func_exit;
+			}
+
+			recv_sys_t::map::iterator p
+				= recv_sys.pages.find(page_id);
+			if (p == recv_sys.pages.end()
+			    || p->second.state
+			    != page_recv_t::RECV_NOT_PROCESSED) {
+				break;
+			}
+
+			mtr.start();
+			mtr.set_log_mode(MTR_LOG_NONE);
+			if (buf_block_t* block = buf_page_get_gen(
+				    page_id, 0, RW_X_LATCH, NULL,
+				    BUF_GET_IF_IN_POOL,
+				    __FILE__, __LINE__, &mtr, NULL)) {
+				buf_block_dbg_add_level(
+					block, SYNC_NO_ORDER_CHECK);
+				recv_recover_page(block, mtr, p);
+				ut_ad(mtr.has_committed());
+			} else {
+				mtr.commit();
+				recv_read_in_area(page_id);
+			}
+		}
+	}
+
+func_exit:
+	mutex_exit(&recv_sys.mutex);
+}
+
+/** Distribute the pages of recv_sys.pages that are waiting to be
+processed to srv_recovery_apply_tasks tasks.
+@param[out]	slices	the work of the submitted tasks */
+static void recv_apply_submit(std::vector<recv_apply_slice_t>& slices)
+{
+	ut_ad(mutex_own(&recv_sys.mutex));
+	ut_ad(slices.empty());
+
+	ulint n_pages = 0;
+
+	for (const auto& p : recv_sys.pages) {
+		n_pages += p.second.state == page_recv_t::RECV_NOT_PROCESSED;
+	}
+
+	if (!n_pages) {
+		return;
+	}
+
+	/* Assign contiguous ranges of pages to each task, so that
+	the reads initiated by recv_read_in_area() will rarely
+	overlap between the tasks. */
+	const ulint n_tasks = std::min<ulint>(srv_recovery_apply_tasks,
+					      n_pages);
+	const ulint n_per_task = (n_pages + n_tasks - 1) / n_tasks;
+
+	slices.resize(n_tasks);
+	recv_apply_slice_t* slice = &slices[0];
+
+	for (const auto& p : recv_sys.pages) {
+		if (p.second.state != page_recv_t::RECV_NOT_PROCESSED) {
+			continue;
+		}
+
+		if (slice->pages.size() == n_per_task) {
+			slice++;
+		}
+
+		slice->pages.push_back(p.first);
+	}
+
+	slices.resize(ulint(slice - &slices[0]) + 1);
+
+	for (recv_apply_slice_t& s : slices) {
+		s.task = new tpool::waitable_task(recv_apply_task, &s);
+		srv_thread_pool->submit_task(s.task);
+	}
+}
+
+/** Wait for the tasks that were submitted by recv_apply_submit().
+@param[in,out]	slices	the work of the tasks; will be cleared */
+static void recv_apply_wait(std::vector<recv_apply_slice_t>& slices)
+{
+	ut_ad(mutex_own(&recv_sys.mutex));
+
+	mutex_exit(&recv_sys.mutex);
+
+	for (recv_apply_slice_t& s : slices) {
+		s.task->wait();
+		delete s.task;
+	}
+
+	mutex_enter(&recv_sys.mutex);
+	slices.clear();
+}
+
 /** Apply recv_sys.pages to persistent data pages.
 @param[in]	last_batch	whether redo log writes are possible */
 void recv_apply_hashed_log_recs(bool last_batch)
@@ -2101,6 +2224,12 @@ void recv_apply_hashed_log_recs(bool last_batch)
 	ut_d(recv_no_log_write = recv_no_ibuf_operations);
 
 	mtr_t mtr;
+	/** the work of the recv_apply_task() */
+	std::vector<recv_apply_slice_t> slices;
+	ulint n_tasks = 0;
+	/** number of pages to recover, for reporting the throughput */
+	const ulint n_pages = recv_sys.pages.size();
+	const ulonglong start_time = my_interval_timer();
 
 	if (recv_sys.pages.empty()) {
 		goto done;
@@ -2136,6 +2265,12 @@ void recv_apply_hashed_log_recs(bool last_batch)
 		}
 	}
 
+	if (srv_recovery_apply_tasks) {
+		recv_apply_submit(slices);
+		n_tasks = slices.size();
+	}
+
+apply_pages:
 	for (recv_sys_t::map::iterator p = recv_sys.pages.begin();
 	     p != recv_sys.pages.end();) {
 		const page_id_t page_id = p->first;
@@ -2148,6 +2283,12 @@ void recv_apply_hashed_log_recs(bool last_batch)
 			p++;
 			continue;
 		case page_recv_t::RECV_NOT_PROCESSED:
+			if (!slices.empty()) {
+				/* This is being taken care of by
+				recv_apply_task(). */
+				p++;
+				continue;
+			}
 		apply:
 			mtr.start();
 			mtr.set_log_mode(MTR_LOG_NONE);
@@ -2241,6 +2382,13 @@ void recv_apply_hashed_log_recs(bool last_batch)
 		p = recv_sys.pages.lower_bound(page_id);
 	}
 
+	if (!slices.empty()) {
+		/* Wait for recv_apply_task(), and process anything
+		that it left behind in this thread. */
+		recv_apply_wait(slices);
+		goto apply_pages;
+	}
+
 	/* Wait until all the pages have been processed */
 
 	while (!recv_sys.pages.empty()) {
@@ -2264,6 +2412,15 @@ void recv_apply_hashed_log_recs(bool last_batch)
 	}
 
 done:
+	if (n_pages) {
+		const ulonglong ms = (my_interval_timer() - start_time)
+			/ 1000000;
+		ib::info() << "Applied redo log to " << n_pages << " pages in "
+			   << ms / 1000 << "." << ms % 1000 / 100 << "s ("
+			   << n_pages * 1000 / std::max<ulonglong>(ms, 1)
+			   << " pages/s, " << n_tasks << " tasks)";
+	}
+
 	if (!last_batch) {
 		/* Flush all the file pages to disk and invalidate them in
 		the buffer pool */
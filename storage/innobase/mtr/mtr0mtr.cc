@@ -356,6 +356,21 @@ struct mtr_write_log_t {
 	}
 };
 
+/** Copy the block contents to space that was reserved in the redo log
+buffer while holding log_sys.mutex */
+struct mtr_copy_log_t {
+	/** Position in the redo log buffer */
+	byte*	ptr;
+
+	/** Copy a block to the redo log buffer.
+	@return whether the copying should continue */
+	bool operator()(const mtr_buf_t::block_t* block)
+	{
+		log_copy_low(ptr, block->begin(), block->used());
+		return(true);
+	}
+};
+
 /** Append records to the system-wide redo log buffer.
 @param[in]	log	redo log records */
 void
@@ -421,9 +436,11 @@ mtr_t::commit()
     ut_ad(!srv_read_only_mode || m_log_mode == MTR_LOG_NO_REDO);
 
     lsn_t start_lsn;
+    mtr_copy_log_t copy_log;
+    copy_log.ptr= NULL;
 
     if (const ulint len= prepare_write())
-      start_lsn= finish_write(len);
+      start_lsn= finish_write(len, &copy_log.ptr);
     else
       start_lsn= m_commit_lsn;
 
@@ -441,6 +458,15 @@ mtr_t::commit()
     if (m_made_dirty)
       log_flush_order_mutex_exit();
 
+    if (copy_log.ptr)
+    {
+      /* The pages cannot be written out before the log is copied,
+      because we are still holding their latches, and the log cannot
+      be written out until log_sys.wait_for_copies() returns. */
+      m_log.for_each_block(copy_log);
+      log_sys.finish_copy();
+    }
+
     m_memo.for_each_block_in_reverse(CIterate<ReleaseLatches>());
   }
   else
@@ -682,10 +708,14 @@ inline ulint mtr_t::prepare_write()
 	return(len);
 }
 
-/** Append the redo log records to the redo log buffer
-@param[in] len	number of bytes to write
+/** Append the redo log records to the redo log buffer.
+@param[in]	len	number of bytes to write
+@param[out]	copy	NULL to copy the records while holding
+			log_sys.mutex; else where the caller must
+			copy them after releasing log_sys.mutex,
+			or NULL if they were already copied
 @return start_lsn */
-inline lsn_t mtr_t::finish_write(ulint len)
+inline lsn_t mtr_t::finish_write(ulint len, byte** copy)
 {
 	ut_ad(m_log_mode == MTR_LOG_ALL);
 	ut_ad(log_mutex_own());
@@ -709,8 +739,16 @@ inline lsn_t mtr_t::finish_write(ulint len)
 	/* Open the database log for log_write_low */
 	start_lsn = log_reserve_and_open(len);
 
-	mtr_write_log_t	write_log;
-	m_log.for_each_block(write_log);
+	if (copy) {
+		/* Only reserve the space, so that the records can be
+		copied concurrently with other mini-transaction commits. */
+		*copy = log_sys.buf + log_sys.buf_free;
+		log_sys.start_copy();
+		log_write_low(NULL, len);
+	} else {
+		mtr_write_log_t	write_log;
+		m_log.for_each_block(write_log);
+	}
 
 	m_commit_lsn = log_close();
 	return start_lsn;
@@ -93,9 +93,9 @@ class io_slots
 	{
 	}
 	/* Get cached AIO control block */
-	tpool::aiocb* acquire()
+	tpool::aiocb* acquire(bool blocking = true)
 	{
-		return m_cache.get();
+		return m_cache.get(blocking);
 	}
 	/* Release AIO control block back to cache */
 	void release(tpool::aiocb* aiocb)
@@ -4045,17 +4045,45 @@ bool os_aio_init(ulint n_reader_threads, ulint n_writer_threads, ulint)
 	int max_read_events = (int)n_reader_threads * OS_AIO_N_PENDING_IOS_PER_THREAD;
 	int max_ibuf_events = 1 * OS_AIO_N_PENDING_IOS_PER_THREAD;
 	int max_events = max_read_events + max_write_events + max_ibuf_events;
-	int ret;
-
+	int ret = -1;
+
+#if defined LINUX_NATIVE_AIO && defined HAVE_URING
+	const tpool::aio_implementation impl
+		= static_cast<tpool::aio_implementation>(srv_linux_aio);
+	if (srv_use_native_aio && impl != tpool::aio_implementation::LINUX_AIO) {
+		/* io_uring does not have the file system limitations
+		that is_linux_native_aio_supported() checks for */
+		ret = srv_thread_pool->configure_aio(
+			true, max_events, tpool::aio_implementation::IO_URING);
+		if (ret) {
+			ib::info() << "io_uring is not available;"
+				" falling back to libaio";
+		} else {
+			/* Make innodb_linux_aio show what is in use */
+			srv_linux_aio = ulong(
+				tpool::aio_implementation::IO_URING);
+		}
+	}
+#endif
+	if (ret) {
 #if LINUX_NATIVE_AIO
-	if (srv_use_native_aio && !is_linux_native_aio_supported())
-		srv_use_native_aio = false;
+		if (srv_use_native_aio && !is_linux_native_aio_supported())
+			srv_use_native_aio = false;
+#endif
+		ret = srv_thread_pool->configure_aio(
+			srv_use_native_aio, max_events,
+			tpool::aio_implementation::LINUX_AIO);
+#ifdef __linux__
+		if (!ret && srv_use_native_aio) {
+			srv_linux_aio = ulong(
+				tpool::aio_implementation::LINUX_AIO);
+		}
 #endif
-	ret = srv_thread_pool->configure_aio(srv_use_native_aio, max_events);
+	}
 	if(ret) {
 		ut_a(srv_use_native_aio);
 		srv_use_native_aio = false;
-#ifdef LINUX_NATIVE_AIO
+#if defined LINUX_NATIVE_AIO || defined HAVE_URING
 		ib::info() << "Linux native AIO disabled";
 #endif
 		ret = srv_thread_pool->configure_aio(srv_use_native_aio, max_events);
@@ -4094,6 +4122,99 @@ void os_aio_wait_until_no_pending_writes()
 }
 
 
+/** Maximum number of reads collected by os_aio_batch_begin() */
+static constexpr size_t OS_AIO_MAX_BATCH = 64;
+
+/** Asynchronous reads collected by os_aio_batch_begin() */
+struct os_aio_batch_t
+{
+	/** whether os_aio_batch_begin() is in effect */
+	bool			active;
+	/** number of collected reads */
+	size_t			n;
+	/** collected reads */
+	tpool::aiocb*		cbs[OS_AIO_MAX_BATCH];
+	/** file names, for error reporting */
+	const char*		names[OS_AIO_MAX_BATCH];
+};
+
+/** Asynchronous reads collected by the current thread */
+static thread_local os_aio_batch_t os_aio_batch;
+
+/** Submit the collected asynchronous reads of the current thread. */
+static void os_aio_batch_submit()
+{
+	os_aio_batch_t&	batch = os_aio_batch;
+	size_t		n = batch.n;
+
+	if (!n) {
+		return;
+	}
+
+	batch.n = 0;
+
+	for (size_t i = srv_thread_pool->submit_io_batch(batch.cbs, n);
+	     i < n; i++) {
+		/* Retry the remaining requests one by one.
+		The request was already accounted for in fil_io(),
+		so failure is not an option here (fil_io() would have
+		failed the same way). */
+		if (srv_thread_pool->submit_io(batch.cbs[i])) {
+			os_file_handle_error(batch.names[i], "aio read");
+			ut_error;
+		}
+	}
+}
+
+/** Start collecting the asynchronous reads requested by the current
+thread, instead of submitting them one by one.
+The reads will be submitted by os_aio_batch_end(). */
+void os_aio_batch_begin()
+{
+	ut_ad(!os_aio_batch.active);
+	ut_ad(!os_aio_batch.n);
+	os_aio_batch.active = true;
+}
+
+/** Submit the asynchronous reads collected since os_aio_batch_begin(). */
+void os_aio_batch_end()
+{
+	ut_ad(os_aio_batch.active);
+	os_aio_batch.active = false;
+	os_aio_batch_submit();
+}
+
+/** Register the memory areas that will be used as IO buffers
+with the asynchronous IO subsystem.
+@param[in]	bufs	start addresses of the areas
+@param[in]	lens	lengths of the areas, in bytes
+@param[in]	n	number of areas */
+void os_aio_register_buffers(void* const* bufs, const size_t* lens, size_t n)
+{
+	if (!srv_use_native_aio || !srv_thread_pool) {
+		return;
+	}
+
+	switch (int err = srv_thread_pool->register_buffers(bufs, lens, n)) {
+	case 0:
+	case ENOTSUP:
+		break;
+	default:
+		/* Most likely RLIMIT_MEMLOCK is too small.
+		The IO will work with unregistered buffers as well. */
+		ib::warn() << "Failed to register the buffer pool memory"
+			" for asynchronous IO: " << strerror(err);
+	}
+}
+
+/** Forget the buffers registered by os_aio_register_buffers(). */
+void os_aio_unregister_buffers()
+{
+	if (srv_thread_pool) {
+		srv_thread_pool->unregister_buffers();
+	}
+}
+
 /**
 NOTE! Use the corresponding macro os_aio(), not directly this function!
 Requests an asynchronous i/o operation.
@@ -4165,7 +4286,13 @@ os_aio_func(
 	} else {
 		slots = write_slots;
 	}
-	tpool::aiocb* cb = slots->acquire();
+	tpool::aiocb* cb = slots->acquire(false);
+	if (!cb) {
+		/* Do not wait for a free slot while holding
+		unsubmitted ones. */
+		os_aio_batch_submit();
+		cb = slots->acquire();
+	}
 
 	cb->m_buffer = buf;
 	cb->m_callback = (tpool::callback_func)io_callback;
@@ -4181,6 +4308,16 @@ os_aio_func(
 	ut_a(cb->m_len % OS_FILE_LOG_BLOCK_SIZE == 0);
 	ut_a(cb->m_offset % OS_FILE_LOG_BLOCK_SIZE == 0);
 
+	if (os_aio_batch.active && type.is_read()) {
+		os_aio_batch_t&	batch = os_aio_batch;
+		batch.cbs[batch.n] = cb;
+		batch.names[batch.n] = name;
+		if (++batch.n == OS_AIO_MAX_BATCH) {
+			os_aio_batch_submit();
+		}
+		return DB_SUCCESS;
+	}
+
 	if (!srv_thread_pool->submit_io(cb))
 		return DB_SUCCESS;
 
@@ -3111,6 +3111,131 @@ row_merge_blocks_copy(
 		    != NULL);
 }
 
+/** A merge of one or two runs in a pass of row_merge() */
+struct row_merge_job_t
+{
+	/** first block of the first input run */
+	ulint		foffs0;
+	/** first block of the second input run, or ULINT_UNDEFINED
+	if the first run is to be copied as is */
+	ulint		foffs1;
+	/** first block of the output run */
+	ulint		out;
+	/** the block after the last one written to the output run */
+	ulint		end;
+	/** number of records written to the output run */
+	ulint		n_rec;
+};
+
+/** A merge pass, whose jobs may be executed by several threads */
+struct row_merge_pass_t
+{
+	/** transaction */
+	trx_t*			trx;
+	/** descriptor of index being created */
+	const row_merge_dup_t*	dup;
+	/** input file */
+	const merge_file_t*	file;
+	/** output file */
+	pfs_os_file_t		fd;
+	/** tablespace ID for encryption */
+	ulint			space;
+	/** the merges to perform */
+	row_merge_job_t*	jobs;
+	/** number of elements in jobs[] */
+	ulint			n_jobs;
+	/** the next job to be claimed */
+	std::atomic<ulint>	next;
+	/** the first error that was encountered */
+	std::atomic<dberr_t>	error;
+};
+
+/** A helper thread of row_merge_sort() */
+struct row_merge_worker_t
+{
+	/** the pass that is being executed */
+	row_merge_pass_t*	pass;
+	/** 3 buffers */
+	row_merge_block_t*	block;
+	/** encryption buffer, or NULL */
+	row_merge_block_t*	crypt_block;
+	/** descriptor of block */
+	ut_new_pfx_t		block_pfx;
+	/** descriptor of crypt_block */
+	ut_new_pfx_t		crypt_pfx;
+	/** the task that executes row_merge_worker() */
+	tpool::waitable_task*	task;
+};
+
+/** Claim and execute jobs of a merge pass until none are left.
+@param[in,out]	pass		merge pass
+@param[in,out]	block		3 buffers
+@param[in,out]	crypt_block	encryption buffer
+@param[in,out]	stage		performance schema accounting object, or NULL */
+static
+void
+row_merge_pass_run(
+	row_merge_pass_t*	pass,
+	row_merge_block_t*	block,
+	row_merge_block_t*	crypt_block,
+	ut_stage_alter_t*	stage)
+{
+	while (pass->error.load(std::memory_order_relaxed) == DB_SUCCESS) {
+		const ulint	i = pass->next.fetch_add(
+			1, std::memory_order_relaxed);
+
+		if (i >= pass->n_jobs) {
+			return;
+		}
+
+		row_merge_job_t&	job = pass->jobs[i];
+		ulint			foffs0 = job.foffs0;
+		ulint			foffs1 = job.foffs1;
+		merge_file_t		of;
+		dberr_t			error;
+
+		of.fd = pass->fd;
+		of.offset = job.out;
+		of.n_rec = 0;
+
+		if (trx_is_interrupted(pass->trx)) {
+			error = DB_INTERRUPTED;
+		} else if (foffs1 == ULINT_UNDEFINED) {
+			error = row_merge_blocks_copy(
+				pass->dup->index, pass->file, block,
+				&foffs0, &of, stage,
+				crypt_block, pass->space)
+				? DB_SUCCESS : DB_CORRUPTION;
+		} else {
+			error = row_merge_blocks(
+				pass->dup, pass->file, block,
+				&foffs0, &foffs1, &of, stage,
+				crypt_block, pass->space);
+		}
+
+		job.end = of.offset;
+		job.n_rec = of.n_rec;
+
+		if (error != DB_SUCCESS) {
+			dberr_t	success = DB_SUCCESS;
+			pass->error.compare_exchange_strong(success, error);
+			return;
+		}
+	}
+}
+
+/** Execute jobs of a merge pass in a helper thread.
+@param[in,out]	arg	row_merge_worker_t */
+static void row_merge_worker(void* arg)
+{
+	row_merge_worker_t*	worker = static_cast<row_merge_worker_t*>(arg);
+
+	/* ut_stage_alter_t::inc() may only be invoked by the thread
+	that is executing the ALTER TABLE. */
+	row_merge_pass_run(worker->pass, worker->block,
+			   worker->crypt_block, NULL);
+}
+
 /** Merge disk files.
 @param[in]	trx		transaction
 @param[in]	dup		descriptor of index being created
@@ -3120,6 +3245,9 @@ row_merge_blocks_copy(
 @param[in,out]	num_run		Number of runs that remain to be merged
 @param[in,out]	run_offset	Array that contains the first offset number
 for each merge run
+@param[out]	jobs		Array of (*num_run + 1) / 2 merges
+@param[in,out]	workers		helper threads
+@param[in]	n_workers	number of elements in workers[]
 @param[in,out]	stage		performance schema accounting object, used by
 @param[in,out]	crypt_block	encryption buffer
 @param[in]	space		tablespace ID for encryption
@@ -3136,18 +3264,21 @@ row_merge(
 	pfs_os_file_t*		tmpfd,
 	ulint*			num_run,
 	ulint*			run_offset,
+	row_merge_job_t*	jobs,
+	row_merge_worker_t*	workers,
+	ulint			n_workers,
 	ut_stage_alter_t*	stage,
 	row_merge_block_t*	crypt_block,
 	ulint			space)
 {
-	ulint		foffs0;	/*!< first input offset */
-	ulint		foffs1;	/*!< second input offset */
-	dberr_t		error;	/*!< error code */
 	merge_file_t	of;	/*!< output file */
-	const ulint	ihalf	= run_offset[*num_run / 2];
+	const ulint	n_half	= *num_run / 2;
+				/*!< number of runs in the first half */
+	const ulint	ihalf	= run_offset[n_half];
 				/*!< half the input file */
-	ulint		n_run	= 0;
+	ulint		n_job	= 0;
 				/*!< num of runs generated from this merge */
+	row_merge_pass_t pass;
 
 	UNIV_MEM_ASSERT_W(&block[0], 3 * srv_sort_buf_size);
 
@@ -3157,10 +3288,6 @@ row_merge(
 
 	ut_ad(ihalf < file->offset);
 
-	of.fd = *tmpfd;
-	of.offset = 0;
-	of.n_rec = 0;
-
 #ifdef POSIX_FADV_SEQUENTIAL
 	/* The input file will be read sequentially, starting from the
 	beginning and the middle.  In Linux, the POSIX_FADV_SEQUENTIAL
@@ -3169,76 +3296,76 @@ row_merge(
 		      POSIX_FADV_SEQUENTIAL | POSIX_FADV_NOREUSE);
 #endif /* POSIX_FADV_SEQUENTIAL */
 
-	/* Merge blocks to the output file. */
-	foffs0 = 0;
-	foffs1 = ihalf;
-
-	UNIV_MEM_INVALID(run_offset, *num_run * sizeof *run_offset);
-
-	for (; foffs0 < ihalf && foffs1 < file->offset; foffs0++, foffs1++) {
-
-		if (trx_is_interrupted(trx)) {
-			return(DB_INTERRUPTED);
-		}
-
-		/* Remember the offset number for this run */
-		run_offset[n_run++] = of.offset;
-
-		error = row_merge_blocks(dup, file, block,
-					 &foffs0, &foffs1, &of, stage,
-					 crypt_block, space);
+	/* Merge the i-th run of each half of the input file.  The output
+	of a merge never occupies more blocks than its inputs, so each
+	output run can be assigned a fixed position that does not
+	overlap with the others, and the merges can be executed in any
+	order.  Any blocks between the output runs will not be read. */
+	for (; n_job < n_half; n_job++) {
+		row_merge_job_t&	job = jobs[n_job];
+
+		job.foffs0 = run_offset[n_job];
+		job.foffs1 = run_offset[n_half + n_job];
+		job.out = job.foffs0 + job.foffs1 - ihalf;
+	}
 
-		if (error != DB_SUCCESS) {
-			return(error);
-		}
+	/* Copy the last run of an odd number of runs. */
+	if (*num_run & 1) {
+		row_merge_job_t&	job = jobs[n_job++];
 
+		job.foffs0 = run_offset[*num_run - 1];
+		job.foffs1 = ULINT_UNDEFINED;
+		job.out = job.foffs0;
 	}
 
-	/* Copy the last blocks, if there are any. */
-
-	while (foffs0 < ihalf) {
+	UNIV_MEM_INVALID(run_offset, *num_run * sizeof *run_offset);
 
-		if (UNIV_UNLIKELY(trx_is_interrupted(trx))) {
-			return(DB_INTERRUPTED);
-		}
+	pass.trx = trx;
+	pass.dup = dup;
+	pass.file = file;
+	pass.fd = *tmpfd;
+	pass.space = space;
+	pass.jobs = jobs;
+	pass.n_jobs = n_job;
+	pass.next = 0;
+	pass.error = DB_SUCCESS;
+
+	n_workers = std::min(n_workers, n_job - 1);
+
+	for (ulint i = 0; i < n_workers; i++) {
+		workers[i].pass = &pass;
+		srv_thread_pool->submit_task(workers[i].task);
+	}
 
-		/* Remember the offset number for this run */
-		run_offset[n_run++] = of.offset;
+	row_merge_pass_run(&pass, block, crypt_block, stage);
 
-		if (!row_merge_blocks_copy(dup->index, file, block,
-					   &foffs0, &of, stage,
-					   crypt_block, space)) {
-			return(DB_CORRUPTION);
-		}
+	for (ulint i = 0; i < n_workers; i++) {
+		workers[i].task->wait();
 	}
 
-	ut_ad(foffs0 == ihalf);
+	dberr_t	error = pass.error;
 
-	while (foffs1 < file->offset) {
+	if (error != DB_SUCCESS) {
+		return(error);
+	}
 
-		if (trx_is_interrupted(trx)) {
-			return(DB_INTERRUPTED);
-		}
+	of.fd = *tmpfd;
+	of.offset = jobs[n_job - 1].end;
+	of.n_rec = 0;
 
+	for (ulint i = 0; i < n_job; i++) {
 		/* Remember the offset number for this run */
-		run_offset[n_run++] = of.offset;
-
-		if (!row_merge_blocks_copy(dup->index, file, block,
-					   &foffs1, &of, stage,
-					   crypt_block, space)) {
-			return(DB_CORRUPTION);
-		}
+		run_offset[i] = jobs[i].out;
+		of.n_rec += jobs[i].n_rec;
 	}
 
-	ut_ad(foffs1 == file->offset);
-
 	if (UNIV_UNLIKELY(of.n_rec != file->n_rec)) {
 		return(DB_CORRUPTION);
 	}
 
-	ut_ad(n_run <= *num_run);
+	ut_ad(n_job <= *num_run);
 
-	*num_run = n_run;
+	*num_run = n_job;
 
 	/* Each run can contain one or more offsets. As merge goes on,
 	the number of runs (to merge) will reduce until we have one
@@ -3268,6 +3395,7 @@ row_merge(
 @param[in,out]	stage	performance schema accounting object, used by
 ALTER TABLE. If not NULL, stage->begin_phase_sort() will be called initially
 and then stage->inc() will be called for each record processed.
+@param[in]	n_threads	maximum number of threads for merging the runs
 @return DB_SUCCESS or error code */
 dberr_t
 row_merge_sort(
@@ -3285,11 +3413,14 @@ row_merge_sort(
 	const double		pct_cost, /*!< in: current progress percent */
 	row_merge_block_t*	crypt_block, /*!< in: crypt buf or NULL */
 	ulint			space,	   /*!< in: space id */
-	ut_stage_alter_t* 	stage)
+	ut_stage_alter_t* 	stage,
+	ulint			n_threads)
 {
-	const ulint	half	= file->offset / 2;
 	ulint		num_runs;
 	ulint*		run_offset;
+	row_merge_job_t* jobs;
+	row_merge_worker_t* workers	= NULL;
+	ulint		n_workers	= 0;
 	dberr_t		error	= DB_SUCCESS;
 	ulint		merge_count = 0;
 	ulint		total_merge_sort_count;
@@ -3311,12 +3442,57 @@ row_merge_sort(
 
 	total_merge_sort_count = ulint(ceil(log2(double(num_runs))));
 
-	/* "run_offset" records each run's first offset number */
-	run_offset = (ulint*) ut_malloc_nokey(file->offset * sizeof(ulint));
+	/* "run_offset" records each run's first offset number,
+	followed by the merges of a pass of row_merge() */
+	run_offset = static_cast<ulint*>(
+		ut_malloc_nokey(num_runs * sizeof(ulint)
+				+ (num_runs + 1) / 2
+				* sizeof(row_merge_job_t)));
+	jobs = reinterpret_cast<row_merge_job_t*>(&run_offset[num_runs]);
+
+	/* Initially, each block is a run of its own. */
+	for (ulint i = 0; i < num_runs; i++) {
+		run_offset[i] = i;
+	}
+
+	/* Merges of a unique index report duplicates to dup,
+	which is not safe to do from several threads. */
+	if (n_threads > 1 && num_runs > 2
+	    && !dict_index_is_unique(dup->index)) {
+		n_workers = std::min(n_threads, (num_runs + 1) / 2) - 1;
+		workers = static_cast<row_merge_worker_t*>(
+			ut_zalloc_nokey(n_workers * sizeof *workers));
+	}
+
+	if (workers) {
+		ut_allocator<row_merge_block_t>	alloc(mem_key_row_merge_sort);
+
+		for (ulint i = 0; i < n_workers; i++) {
+			row_merge_worker_t&	w = workers[i];
+
+			w.block = alloc.allocate_large(3 * srv_sort_buf_size,
+						       &w.block_pfx);
+			if (w.block && crypt_block) {
+				w.crypt_block = alloc.allocate_large(
+					3 * srv_sort_buf_size, &w.crypt_pfx);
+				if (!w.crypt_block) {
+					alloc.deallocate_large(
+						w.block, &w.block_pfx,
+						3 * srv_sort_buf_size);
+					w.block = NULL;
+				}
+			}
+
+			if (!w.block) {
+				/* Make do with fewer threads. */
+				n_workers = i;
+				break;
+			}
 
-	/* This tells row_merge() where to start for the first round
-	of merge. */
-	run_offset[half] = half;
+			w.task = new tpool::waitable_task(row_merge_worker,
+							  &w);
+		}
+	}
 
 	/* The file should always contain at least one byte (the end
 	of file marker).  Thus, it must be at least one block. */
@@ -3351,7 +3527,8 @@ row_merge_sort(
 #endif /* UNIV_SOLARIS */
 
 		error = row_merge(trx, dup, file, block, tmpfd,
-				  &num_runs, run_offset, stage,
+				  &num_runs, run_offset, jobs,
+				  workers, n_workers, stage,
 				  crypt_block, space);
 
 		if(update_progress) {
@@ -3370,6 +3547,25 @@ row_merge_sort(
 		UNIV_MEM_ASSERT_RW(run_offset, num_runs * sizeof *run_offset);
 	} while (num_runs > 1);
 
+	if (workers) {
+		ut_allocator<row_merge_block_t>	alloc(mem_key_row_merge_sort);
+
+		for (ulint i = 0; i < n_workers; i++) {
+			row_merge_worker_t&	w = workers[i];
+
+			delete w.task;
+			alloc.deallocate_large(w.block, &w.block_pfx,
+					       3 * srv_sort_buf_size);
+			if (w.crypt_block) {
+				alloc.deallocate_large(w.crypt_block,
+						       &w.crypt_pfx,
+						       3 * srv_sort_buf_size);
+			}
+		}
+
+		ut_free(workers);
+	}
+
 	ut_free(run_offset);
 
 	/* Progress report only for "normal" indexes. */
@@ -4784,7 +4980,7 @@ row_merge_build_indexes(
 					block, &tmpfd, true,
 					pct_progress, pct_cost,
 					crypt_block, new_table->space_id,
-					stage);
+					stage, srv_merge_sort_threads);
 
 			pct_progress += pct_cost;
 
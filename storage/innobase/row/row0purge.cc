@@ -381,6 +381,94 @@ row_purge_remove_sec_if_poss_tree(
 	return(success);
 }
 
+/** Try to position a cursor on a secondary index record on the leaf page
+where the previous record of the index was purged, without a B-tree descent.
+The undo log records are sorted by trx_purge_attach_undo_recs(), so that
+consecutive purges of the same index often hit the same leaf page.
+@param[in,out]	node	row purge node
+@param[in]	index	committed secondary index, not SPATIAL INDEX
+@param[in]	entry	secondary index entry
+@param[out]	pcur	cursor on the index record
+@param[in,out]	mtr	mini-transaction
+@return whether the record was found on the page and exclusively latched */
+static MY_ATTRIBUTE((nonnull, warn_unused_result))
+bool
+row_purge_sec_leaf_search(
+	purge_node_t*	node,
+	dict_index_t*	index,
+	const dtuple_t*	entry,
+	btr_pcur_t*	pcur,
+	mtr_t*		mtr)
+{
+	const purge_node_t::sec_leaf_t* leaf = node->sec_leaf(index);
+
+	if (!leaf || buf_pool_is_obsolete(leaf->withdraw_clock)) {
+		return false;
+	}
+
+	buf_block_t*	block = leaf->block;
+	const ulint	savepoint = mtr->get_savepoint();
+
+	if (!buf_page_optimistic_get(RW_X_LATCH, block, leaf->modify_clock,
+				     __FILE__, __LINE__, mtr)) {
+		return false;
+	}
+
+	buf_block_dbg_add_level(block, SYNC_TREE_NODE);
+
+	btr_cur_t*	btr_cur = btr_pcur_get_btr_cur(pcur);
+	ulint		up_match = 0;
+	ulint		low_match = 0;
+
+	/* An unchanged modify_clock implies that the page still is
+	a leaf page of the index, but do not take that for granted. */
+	if (page_is_leaf(block->frame)
+	    && btr_page_get_index_id(block->frame) == index->id
+	    && block->page.id.space() == index->table->space_id) {
+		page_cur_search_with_match(block, index, entry, PAGE_CUR_LE,
+					   &up_match, &low_match,
+					   btr_cur_get_page_cur(btr_cur),
+					   NULL);
+	}
+
+	if (low_match != dtuple_get_n_fields(entry)) {
+		mtr->release_block_at_savepoint(savepoint, block);
+		return false;
+	}
+
+	btr_cur->index = index;
+	btr_cur->low_match = low_match;
+	btr_cur->up_match = up_match;
+	pcur->latch_mode = BTR_MODIFY_LEAF;
+	pcur->pos_state = BTR_PCUR_IS_POSITIONED;
+	pcur->old_stored = false;
+	return true;
+}
+
+/** Remember the leaf page where a secondary index record was purged.
+@param[in,out]	node	row purge node
+@param[in]	index	secondary index
+@param[in]	block	exclusively latched leaf page */
+static
+void
+row_purge_sec_leaf_store(
+	purge_node_t*		node,
+	const dict_index_t*	index,
+	buf_block_t*		block)
+{
+	purge_node_t::sec_leaf_t* leaf = node->sec_leaf(index);
+
+	if (!leaf) {
+		node->sec_leaves.push_back(purge_node_t::sec_leaf_t());
+		leaf = &node->sec_leaves.back();
+		leaf->index = index;
+	}
+
+	leaf->block = block;
+	leaf->modify_clock = buf_block_get_modify_clock(block);
+	leaf->withdraw_clock = buf_withdraw_clock;
+}
+
 /***************************************************************
 Removes a secondary index entry without modifying the index tree,
 if possible.
@@ -453,8 +541,17 @@ row_purge_remove_sec_if_poss_leaf(
 			que_node_get_parent(node));
 	}
 
-	search_result = row_search_index_entry(
-		index, entry, mode, &pcur, &mtr);
+	if (mode == BTR_PURGE_LEAF_ALREADY_S_LATCHED
+	    || dict_index_is_spatial(index)) {
+		search_result = row_search_index_entry(
+			index, entry, mode, &pcur, &mtr);
+	} else if (row_purge_sec_leaf_search(node, index, entry,
+					     &pcur, &mtr)) {
+		search_result = ROW_FOUND;
+	} else {
+		search_result = row_search_index_entry(
+			index, entry, mode, &pcur, &mtr);
+	}
 
 	if (dict_index_is_spatial(index)) {
 		rw_lock_sx_unlock(dict_index_get_lock(index));
@@ -522,6 +619,11 @@ row_purge_remove_sec_if_poss_leaf(
 
 				/* The index entry could not be deleted. */
 				success = false;
+			} else if (mode != BTR_PURGE_LEAF_ALREADY_S_LATCHED
+				   && !index->is_spatial()) {
+				row_purge_sec_leaf_store(
+					node, index,
+					btr_cur_get_block(btr_cur));
 			}
 		}
 
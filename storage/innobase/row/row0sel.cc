@@ -52,6 +52,7 @@ Created 12/19/1997 Heikki Tuuri
 #include "pars0pars.h"
 #include "row0mysql.h"
 #include "buf0lru.h"
+#include "buf0rea.h"
 #include "srv0srv.h"
 #include "srv0mon.h"
 #ifdef WITH_WSREP
@@ -70,6 +71,11 @@ to que_run_threads: this is to allow canceling runaway queries */
 
 #define SEL_COST_LIMIT	100
 
+/* An ascending index scan must have crossed this many leaf page
+boundaries before innodb_logical_read_ahead applies to it. Short range
+scans end before that and do not read pages past the end of the range. */
+#define SEL_READ_AHEAD_MIN_LEAVES	2
+
 /* Flags for search shortcut */
 #define SEL_FOUND	0
 #define	SEL_EXHAUSTED	1
@@ -1288,10 +1294,6 @@ void
 row_sel_open_pcur(
 /*==============*/
 	plan_t*		plan,	/*!< in: table plan */
-#ifdef BTR_CUR_HASH_ADAPT
-	rw_lock_t*	ahi_latch,
-				/*!< in: the adaptive hash index latch */
-#endif /* BTR_CUR_HASH_ADAPT */
 	mtr_t*		mtr)	/*!< in/out: mini-transaction */
 {
 	dict_index_t*	index;
@@ -1335,7 +1337,7 @@ row_sel_open_pcur(
 
 		btr_pcur_open_with_no_init(index, plan->tuple, plan->mode,
 					   BTR_SEARCH_LEAF, &plan->pcur,
-					   ahi_latch, mtr);
+					   0, mtr);
 	} else {
 		/* Open the cursor to the start or the end of the index
 		(FALSE: no init) */
@@ -1480,16 +1482,12 @@ row_sel_try_search_shortcut(
 	ut_ad(plan->unique_search);
 	ut_ad(!plan->must_get_clust);
 
-	rw_lock_t* ahi_latch = btr_get_search_latch(index);
-	rw_lock_s_lock(ahi_latch);
-
-	row_sel_open_pcur(plan, ahi_latch, mtr);
+	row_sel_open_pcur(plan, mtr);
 
 	const rec_t* rec = btr_pcur_get_rec(&(plan->pcur));
 
 	if (!page_rec_is_user_rec(rec) || rec_is_metadata(rec, *index)) {
 retry:
-		rw_lock_s_unlock(ahi_latch);
 		return(SEL_RETRY);
 	}
 
@@ -1501,7 +1499,6 @@ row_sel_try_search_shortcut(
 
 	if (btr_pcur_get_up_match(&(plan->pcur)) < plan->n_exact_match) {
 exhausted:
-		rw_lock_s_unlock(ahi_latch);
 		return(SEL_EXHAUSTED);
 	}
 
@@ -1547,7 +1544,6 @@ row_sel_try_search_shortcut(
 	ut_ad(plan->pcur.latch_mode == BTR_SEARCH_LEAF);
 
 	plan->n_rows_fetched++;
-	rw_lock_s_unlock(ahi_latch);
 
 	if (UNIV_LIKELY_NULL(heap)) {
 		mem_heap_free(heap);
@@ -1669,11 +1665,7 @@ row_sel(
 	if (!plan->pcur_is_open) {
 		/* Evaluate the expressions to build the search tuple and
 		open the cursor */
-		row_sel_open_pcur(plan,
-#ifdef BTR_CUR_HASH_ADAPT
-				  NULL,
-#endif /* BTR_CUR_HASH_ADAPT */
-				  &mtr);
+		row_sel_open_pcur(plan, &mtr);
 
 		cursor_just_opened = TRUE;
 
@@ -3588,6 +3580,104 @@ sel_restore_position_for_mysql(
 	return true;
 }
 
+/** Determine whether an ascending index scan that is about to move
+to the next leaf page should read ahead the following leaf pages.
+@param[in,out]	prebuilt	prebuilt struct for the table handle
+@param[in]	pcur		cursor positioned after the last record
+				of a leaf page
+@return whether row_sel_read_ahead_logical() should be invoked */
+static
+bool
+row_sel_read_ahead_due(row_prebuilt_t* prebuilt, const btr_pcur_t* pcur)
+{
+	const uint32_t	page_no = btr_pcur_get_block(pcur)->page.id.page_no();
+
+	if (page_no != prebuilt->read_ahead_page_no) {
+		/* The scan reached another leaf page. */
+		prebuilt->read_ahead_page_no = page_no;
+		if (prebuilt->n_read_ahead) {
+			prebuilt->n_read_ahead--;
+		}
+	}
+
+	return prebuilt->n_read_ahead <= srv_logical_read_ahead / 2;
+}
+
+/** Read ahead the leaf pages that follow the current leaf page of an
+ascending index scan in key order. The child page numbers are collected
+from the node pointers on the level above the leaf level, so that the
+read-ahead works regardless of the physical placement of the pages.
+@param[in,out]	prebuilt	prebuilt struct for the table handle
+@param[in]	pcur		cursor whose position has been stored;
+				the caller must not hold any page latches */
+static
+void
+row_sel_read_ahead_logical(row_prebuilt_t* prebuilt, const btr_pcur_t* pcur)
+{
+	dict_index_t*	index = pcur->btr_cur.index;
+	const ulint	n = srv_logical_read_ahead;
+
+	ut_ad(pcur->old_stored);
+	ut_ad(!index->is_spatial());
+
+	/* Until the scan has advanced through half of these pages,
+	do not look for more. If the end of the index is reached
+	before that, there is nothing more to read anyway. */
+	prebuilt->n_read_ahead = n;
+
+	if (!pcur->old_rec || !n) {
+		return;
+	}
+
+	mem_heap_t*	heap = mem_heap_create(256 + n * sizeof(uint32_t));
+	uint32_t*	page_nos = static_cast<uint32_t*>(
+		mem_heap_alloc(heap, n * sizeof *page_nos));
+	ulint		n_pages = 0;
+	mtr_t		mtr;
+
+	mtr.start();
+	mtr_s_lock_index(index, &mtr);
+
+	if (btr_height_get(index, &mtr) > 0) {
+		const dtuple_t*	tuple = dict_index_build_data_tuple(
+			pcur->old_rec, index, true, pcur->old_n_fields, heap);
+		btr_pcur_t	node_pcur;
+		offset_t*	offsets = NULL;
+
+		/* Position on the node pointer to the current leaf
+		page, and collect the child pointers that follow it. */
+		if (btr_pcur_open_low(index, 1, tuple, PAGE_CUR_LE,
+				      BTR_SEARCH_TREE_ALREADY_S_LATCHED,
+				      &node_pcur, __FILE__, __LINE__, 0, &mtr)
+		    == DB_SUCCESS) {
+			while (n_pages < n
+			       && btr_pcur_move_to_next_user_rec(&node_pcur,
+								 &mtr)) {
+				const rec_t*	rec = btr_pcur_get_rec(
+					&node_pcur);
+				offsets = rec_get_offsets(
+					rec, index, offsets, false,
+					ULINT_UNDEFINED, &heap);
+				page_nos[n_pages++]
+					= btr_node_ptr_get_child_page_no(
+						rec, offsets);
+			}
+		}
+
+		btr_pcur_close(&node_pcur);
+	}
+
+	mtr.commit();
+
+	if (n_pages) {
+		buf_read_ahead_logical(index->table->space_id,
+				       index->table->space->zip_size(),
+				       page_nos, n_pages);
+	}
+
+	mem_heap_free(heap);
+}
+
 /********************************************************************//**
 Copies a cached field for MySQL from the fetch cache. */
 static
@@ -3713,8 +3803,27 @@ row_sel_dequeue_cached_row_for_mysql(
 	}
 }
 
+/** Determine the number of rows to fetch in the next batch.
+The batch grows with the number of rows that have been fetched since
+the cursor was positioned, so that a short scan (such as one with a
+small LIMIT) does not convert many rows that will never be read, while
+a long scan converts up to a page worth of rows per latch hold.
+@param[in]	prebuilt	prebuilt struct
+@return number of rows to fetch to prebuilt->fetch_cache */
+static
+ulint
+row_sel_fetch_cache_limit(const row_prebuilt_t* prebuilt)
+{
+	ulint	n = srv_page_size / (prebuilt->mysql_row_len + 8);
+
+	n = std::min(n, ulint(MYSQL_FETCH_CACHE_MAX));
+	n = std::min(n, prebuilt->n_rows_fetched);
+
+	return(std::max(n, ulint(MYSQL_FETCH_CACHE_SIZE)));
+}
+
 /********************************************************************//**
-Initialise the prefetch cache. */
+Initialise the prefetch cache for prebuilt->fetch_cache_limit rows. */
 UNIV_INLINE
 void
 row_sel_prefetch_cache_init(
@@ -3725,11 +3834,20 @@ row_sel_prefetch_cache_init(
 	ulint	sz;
 	byte*	ptr;
 
+	ut_ad(prebuilt->n_fetch_cached == 0);
+	ut_ad(prebuilt->fetch_cache_limit <= MYSQL_FETCH_CACHE_MAX);
+
+	if (prebuilt->fetch_cache[0] != NULL) {
+		ut_free(prebuilt->fetch_cache[0] - 4);
+	}
+
+	prebuilt->fetch_cache_alloc = prebuilt->fetch_cache_limit;
+
 	/* Reserve space for the magic number. */
-	sz = UT_ARR_SIZE(prebuilt->fetch_cache) * (prebuilt->mysql_row_len + 8);
+	sz = prebuilt->fetch_cache_alloc * (prebuilt->mysql_row_len + 8);
 	ptr = static_cast<byte*>(ut_malloc_nokey(sz));
 
-	for (i = 0; i < UT_ARR_SIZE(prebuilt->fetch_cache); i++) {
+	for (i = 0; i < prebuilt->fetch_cache_alloc; i++) {
 
 		/* A user has reported memory corruption in these
 		buffers in Linux. Put magic numbers there to help
@@ -3756,9 +3874,9 @@ row_sel_fetch_last_buf(
 	row_prebuilt_t*	prebuilt)	/*!< in/out: prebuilt struct */
 {
 	ut_ad(!prebuilt->templ_contains_blob);
-	ut_ad(prebuilt->n_fetch_cached < MYSQL_FETCH_CACHE_SIZE);
+	ut_ad(prebuilt->n_fetch_cached < prebuilt->fetch_cache_limit);
 
-	if (prebuilt->fetch_cache[0] == NULL) {
+	if (prebuilt->fetch_cache_alloc < prebuilt->fetch_cache_limit) {
 		/* Allocate memory for the fetch cache */
 		ut_ad(prebuilt->n_fetch_cached == 0);
 
@@ -3796,8 +3914,9 @@ row_sel_enqueue_cache_row_for_mysql(
 /*********************************************************************//**
 Tries to do a shortcut to fetch a clustered index record with a unique key,
 using the hash index if possible (not always). We assume that the search
-mode is PAGE_CUR_GE, it is a consistent read, there is a read view in trx,
-btr search latch has been locked in S-mode if AHI is enabled.
+mode is PAGE_CUR_GE, it is a consistent read, there is a read view in trx.
+The adaptive hash index is searched without its latch, and the page of the
+record is latched as in any other search.
 @return SEL_FOUND, SEL_EXHAUSTED, SEL_RETRY */
 static
 ulint
@@ -3818,15 +3937,12 @@ row_sel_try_search_shortcut_for_mysql(
 	ut_ad(dict_index_is_clust(index));
 	ut_ad(!prebuilt->templ_contains_blob);
 
-	rw_lock_t* ahi_latch = btr_get_search_latch(index);
-	rw_lock_s_lock(ahi_latch);
 	btr_pcur_open_with_no_init(index, search_tuple, PAGE_CUR_GE,
-				   BTR_SEARCH_LEAF, pcur, ahi_latch, mtr);
+				   BTR_SEARCH_LEAF, pcur, 0, mtr);
 	rec = btr_pcur_get_rec(pcur);
 
 	if (!page_rec_is_user_rec(rec) || rec_is_metadata(rec, *index)) {
 retry:
-		rw_lock_s_unlock(ahi_latch);
 		return(SEL_RETRY);
 	}
 
@@ -3836,7 +3952,6 @@ row_sel_try_search_shortcut_for_mysql(
 
 	if (btr_pcur_get_up_match(pcur) < dtuple_get_n_fields(search_tuple)) {
 exhausted:
-		rw_lock_s_unlock(ahi_latch);
 		return(SEL_EXHAUSTED);
 	}
 
@@ -3860,7 +3975,6 @@ row_sel_try_search_shortcut_for_mysql(
 
 	*out_rec = rec;
 
-	rw_lock_s_unlock(ahi_latch);
 	return(SEL_FOUND);
 }
 #endif /* BTR_CUR_HASH_ADAPT */
@@ -4247,6 +4361,13 @@ row_search_mvcc(
 		prebuilt->n_rows_fetched = 0;
 		prebuilt->n_fetch_cached = 0;
 		prebuilt->fetch_cache_first = 0;
+		prebuilt->fetch_cache_limit = MYSQL_FETCH_CACHE_SIZE;
+		/* Hold off row_sel_read_ahead_due() until the scan
+		is about to cross a leaf page boundary for the
+		(SEL_READ_AHEAD_MIN_LEAVES + 1)th time. */
+		prebuilt->n_read_ahead = srv_logical_read_ahead / 2
+			+ SEL_READ_AHEAD_MIN_LEAVES + 1;
+		prebuilt->read_ahead_page_no = FIL_NULL;
 
 		if (prebuilt->sel_graph == NULL) {
 			/* Build a dummy select query graph */
@@ -4271,6 +4392,7 @@ row_search_mvcc(
 			prebuilt->n_rows_fetched = 0;
 			prebuilt->n_fetch_cached = 0;
 			prebuilt->fetch_cache_first = 0;
+			prebuilt->fetch_cache_limit = MYSQL_FETCH_CACHE_SIZE;
 
 		} else if (UNIV_LIKELY(prebuilt->n_fetch_cached > 0)) {
 			row_sel_dequeue_cached_row_for_mysql(buf, prebuilt);
@@ -4281,7 +4403,8 @@ row_search_mvcc(
 		}
 
 		if (prebuilt->fetch_cache_first > 0
-		    && prebuilt->fetch_cache_first < MYSQL_FETCH_CACHE_SIZE) {
+		    && prebuilt->fetch_cache_first
+		    < prebuilt->fetch_cache_limit) {
 early_not_found:
 			/* The previous returned row was popped from the fetch
 			cache, but the cache was not full at the time of the
@@ -4297,6 +4420,9 @@ row_search_mvcc(
 			prebuilt->n_rows_fetched = 500000000;
 		}
 
+		prebuilt->fetch_cache_limit = row_sel_fetch_cache_limit(
+			prebuilt);
+
 		mode = pcur->search_mode;
 	}
 
@@ -5339,7 +5465,7 @@ row_search_mvcc(
 		not cache rows because there the cursor is a scrollable
 		cursor. */
 
-		ut_a(prebuilt->n_fetch_cached < MYSQL_FETCH_CACHE_SIZE);
+		ut_a(prebuilt->n_fetch_cached < prebuilt->fetch_cache_limit);
 
 		/* We only convert from InnoDB row format to MySQL row
 		format when ICP is disabled. */
@@ -5391,7 +5517,7 @@ row_search_mvcc(
 			row_sel_enqueue_cache_row_for_mysql(buf, prebuilt);
 		}
 
-		if (prebuilt->n_fetch_cached < MYSQL_FETCH_CACHE_SIZE) {
+		if (prebuilt->n_fetch_cached < prebuilt->fetch_cache_limit) {
 			goto next_rec;
 		}
 
@@ -5523,6 +5649,28 @@ row_search_mvcc(
 
 		mtr.start();
 
+		if (sel_restore_position_for_mysql(&same_user_rec,
+						   BTR_SEARCH_LEAF,
+						   pcur, moves_up, &mtr)) {
+			goto rec_loop;
+		}
+	} else if (moves_up && srv_logical_read_ahead
+		   && !index->table->is_temporary()
+		   && btr_pcur_is_after_last_on_page(pcur)
+		   && !btr_pcur_is_after_last_in_tree(pcur)
+		   && row_sel_read_ahead_due(prebuilt, pcur)) {
+		/* Before moving to the next leaf page, read ahead the
+		following leaf pages in key order. The page latch must
+		be released first, because the read-ahead latches the
+		index and the pages on the level above. */
+
+		btr_pcur_store_position(pcur, &mtr);
+		mtr.commit();
+
+		row_sel_read_ahead_logical(prebuilt, pcur);
+
+		mtr.start();
+
 		if (sel_restore_position_for_mysql(&same_user_rec,
 						   BTR_SEARCH_LEAF,
 						   pcur, moves_up, &mtr)) {
@@ -138,6 +138,9 @@ my_bool	high_level_read_only;
 
 /** Sort buffer size in index creation */
 ulong	srv_sort_buf_size;
+/** innodb_merge_sort_threads; number of threads for merging the sorted
+runs in index creation */
+ulong	srv_merge_sort_threads;
 /** Maximum modification log file size for online index creation */
 unsigned long long	srv_online_max_size;
 
@@ -146,6 +149,10 @@ OS (provided we compiled Innobase with it in), otherwise we will
 use simulated aio we build below with threads.
 Currently we support native aio on windows and linux */
 my_bool	srv_use_native_aio;
+#ifdef __linux__
+/** innodb_linux_aio: native AIO implementation on Linux */
+ulong	srv_linux_aio;
+#endif
 my_bool	srv_numa_interleave;
 /** copy of innodb_use_atomic_writes; @see innodb_init_params() */
 my_bool	srv_use_atomic_writes;
@@ -215,9 +222,9 @@ ulong	srv_buf_pool_chunk_unit;
 ulong	srv_buf_pool_instances;
 /** Default value of innodb_buffer_pool_instances */
 const ulong	srv_buf_pool_instances_default = 0;
-/** innodb_page_hash_locks (a debug-only parameter);
-number of locks to protect buf_pool->page_hash */
-ulong	srv_n_page_hash_locks = 16;
+/** innodb_page_hash_locks; number of locks to protect buf_pool->page_hash
+(0 means that it is determined by the buffer pool size) */
+ulong	srv_n_page_hash_locks;
 /** innodb_lru_scan_depth; number of blocks scanned in LRU flush batch */
 ulong	srv_LRU_scan_depth;
 /** innodb_flush_neighbors; whether or not to flush neighbors of a block */
@@ -251,10 +258,16 @@ my_bool	srv_random_read_ahead;
 in the buffer cache and accessed sequentially for InnoDB to trigger a
 readahead request. */
 ulong	srv_read_ahead_threshold;
+/** innodb_logical_read_ahead; the number of leaf pages to read ahead
+in key order in ascending index range scans, or 0 */
+ulong	srv_logical_read_ahead;
 
 /** innodb_change_buffer_max_size; maximum on-disk size of change
 buffer in terms of percentage of the buffer pool. */
 uint	srv_change_buffer_max_size;
+/** innodb_change_buffer_merge_pct; percentage of innodb_io_capacity
+that the background change buffer merge may use, or 0 */
+uint	srv_change_buffer_merge_pct;
 
 ulong	srv_file_flush_method;
 
@@ -284,6 +297,10 @@ double	srv_max_dirty_pages_pct_lwm;
 which adaptive flushing, if enabled, will kick in. */
 double	srv_adaptive_flushing_lwm;
 
+/** innodb_adaptive_flushing_target; the percentage of log capacity at
+which adaptive flushing tries to keep the checkpoint age, or 0 */
+double	srv_adaptive_flushing_target;
+
 /** innodb_flushing_avg_loops; number of iterations over which
 adaptive flushing is averaged */
 ulong	srv_flushing_avg_loops;
@@ -309,6 +326,10 @@ starting from SRV_FORCE_IGNORE_CORRUPT, so that data can be recovered
 by SELECT or mysqldump. When this is nonzero, we do not allow any user
 modifications to the data. */
 ulong	srv_force_recovery;
+/** innodb_recovery_apply_tasks: number of tpool tasks that apply
+buffered redo log to pages in the buffer pool; 0=apply in the
+recovery thread */
+ulong	srv_recovery_apply_tasks;
 
 /** innodb_print_all_deadlocks; whether to print all user-level
 transactions deadlocks to the error log */
@@ -359,8 +380,10 @@ my_bool	srv_stats_sample_traditional;
 my_bool	srv_use_doublewrite_buf;
 
 /** innodb_doublewrite_batch_size (a debug parameter) specifies the
-number of pages to use in LRU and flush_list batch flushing.
-The rest of the doublewrite buffer is used for single-page flushing. */
+number of pages to use in LRU and flush_list batch flushing. The pages
+are divided evenly between the two doublewrite blocks, which are flushed
+independently of each other. The rest of the doublewrite buffer is used
+for single-page flushing. */
 ulong	srv_doublewrite_batch_size = 120;
 
 /** innodb_replication_delay */
@@ -1437,7 +1460,7 @@ void srv_monitor_task(void*)
 		if (srv_print_innodb_monitor) {
 			/* Reset mutex_skipped counter everytime
 			srv_print_innodb_monitor changes. This is to
-			ensure we will not be blocked by lock_sys.mutex
+			ensure we will not be blocked by lock_sys.latch
 			for short duration information printing,
 			such as requested by sync_array_print_long_waits() */
 			if (!monitor_state.last_srv_print_monitor) {
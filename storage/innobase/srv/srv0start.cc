@@ -963,6 +963,7 @@ srv_shutdown_all_bg_threads()
 
 	lock_sys.timeout_timer.reset();
 	srv_master_timer.reset();
+	ibuf_merge_shutdown();
 
 	if (purge_sys.enabled()) {
 		srv_purge_shutdown();
@@ -2136,6 +2137,7 @@ dberr_t srv_start(bool create_new_db)
 
 		if (srv_force_recovery < SRV_FORCE_NO_BACKGROUND) {
 			srv_start_periodic_timer(srv_master_timer, srv_master_callback, 1000);
+			ibuf_merge_start();
 		}
 	}
 
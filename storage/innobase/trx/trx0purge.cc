@@ -42,6 +42,7 @@ Created 3/26/1996 Heikki Tuuri
 #include "trx0rseg.h"
 #include "trx0trx.h"
 #include <mysql/service_wsrep.h>
+#include <algorithm>
 
 /** Maximum allowable purge history length.  <=0 means 'infinite'. */
 ulong		srv_max_purge_lag = 0;
@@ -1087,7 +1088,74 @@ trx_purge_fetch_next_rec(
 	return(trx_purge_get_next_rec(n_pages_handled, heap));
 }
 
+/** An undo log record along with its sort key for
+trx_purge_attach_undo_recs() */
+struct trx_purge_sort_rec_t
+{
+  /** Record to purge */
+  trx_purge_rec_t rec;
+  /** table identifier */
+  table_id_t table_id;
+  /** first PRIMARY KEY field of the record, or NULL */
+  const byte *key;
+  /** length of key */
+  ulint key_len;
+
+  /** Compare the records by (table_id, key).
+  Records of the same table and PRIMARY KEY will compare equal. */
+  bool operator<(const trx_purge_sort_rec_t &other) const
+  {
+    if (table_id != other.table_id)
+      return table_id < other.table_id;
+    if (int cmp= memcmp(key, other.key, std::min(key_len, other.key_len)))
+      return cmp < 0;
+    return key_len < other.key_len;
+  }
+};
+
+/** Parse the table identifier and the first PRIMARY KEY field
+of an undo log record.
+@param[in,out]	rec	undo log record to be purged */
+static void trx_purge_get_sort_key(trx_purge_sort_rec_t *rec)
+{
+  ulint type, cmpl_info;
+  bool updated_extern;
+  undo_no_t undo_no;
+  const byte *ptr= trx_undo_rec_get_pars(rec->rec.undo_rec, &type,
+                                         &cmpl_info, &updated_extern,
+                                         &undo_no, &rec->table_id);
+  rec->key= field_ref_zero;
+  rec->key_len= 0;
+
+  switch (type) {
+  case TRX_UNDO_UPD_DEL_REC:
+  case TRX_UNDO_UPD_EXIST_REC:
+  case TRX_UNDO_DEL_MARK_REC:
+    trx_id_t trx_id;
+    roll_ptr_t roll_ptr;
+    ulint info_bits;
+    ptr= trx_undo_update_rec_get_sys_cols(ptr, &trx_id, &roll_ptr,
+                                          &info_bits);
+    /* fall through */
+  case TRX_UNDO_INSERT_REC:
+    const byte *field;
+    ulint len, orig_len;
+    trx_undo_rec_get_col_val(ptr, &field, &len, &orig_len);
+    if (field && len != UNIV_SQL_NULL && !orig_len)
+    {
+      rec->key= field;
+      rec->key_len= len;
+    }
+  }
+}
+
 /** Run a purge batch.
+
+The undo log records of each table are assigned to a single purge
+thread, in the order of the first PRIMARY KEY column. This keeps the
+accesses to the clustered and secondary indexes local, so that
+row_purge_remove_sec_if_poss_leaf() can often skip the B-tree descent.
+The records of the same row are processed in their original order.
 @param n_purge_threads	number of purge threads
 @return number of undo log pages handled in the batch */
 static
@@ -1137,6 +1205,7 @@ trx_purge_attach_undo_recs(ulint n_purge_threads)
 
 	const ulint		batch_size = srv_purge_batch_size;
 	std::map<table_id_t, purge_node_t*>	table_id_map;
+	std::vector<trx_purge_sort_rec_t>	recs;
 	mem_heap_empty(purge_sys.heap);
 
 	while (UNIV_LIKELY(srv_undo_sources) || !srv_fast_shutdown) {
@@ -1167,14 +1236,11 @@ trx_purge_attach_undo_recs(ulint n_purge_threads)
 			continue;
 		}
 
-		table_id_t table_id = trx_undo_rec_get_table_id(
-			purge_rec.undo_rec);
+		trx_purge_sort_rec_t rec;
+		rec.rec = purge_rec;
+		trx_purge_get_sort_key(&rec);
 
-		auto it = table_id_map.find(table_id);
-
-		if (it != table_id_map.end()) {
-			node = it->second;
-		} else {
+		if (table_id_map.find(rec.table_id) == table_id_map.end()) {
 			thr = UT_LIST_GET_NEXT(thrs, thr);
 
 			if (!(++i % n_purge_threads)) {
@@ -1183,16 +1249,23 @@ trx_purge_attach_undo_recs(ulint n_purge_threads)
 			}
 
 			ut_a(thr != NULL);
-			table_id_map.insert({table_id, node});
+			table_id_map.insert({rec.table_id, node});
 		}
 
-		node->undo_recs.push(purge_rec);
+		recs.push_back(rec);
 
 		if (n_pages_handled >= batch_size) {
 			break;
 		}
 	}
 
+	std::stable_sort(recs.begin(), recs.end());
+
+	for (const trx_purge_sort_rec_t& rec : recs) {
+		table_id_map.find(rec.table_id)->second->undo_recs.push(
+			rec.rec);
+	}
+
 	ut_ad(purge_sys.head <= purge_sys.tail);
 
 	return(n_pages_handled);
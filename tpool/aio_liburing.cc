@@ -0,0 +1,317 @@
+/* Copyright(C) 2020 MariaDB Corporation.
+
+This program is free software; you can redistribute itand /or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02111 - 1301 USA*/
+
+#include "tpool_structs.h"
+#include "tpool.h"
+
+#include <liburing.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+/*
+  Linux AIO implementation, based on io_uring.
+  Needs liburing.h and -luring at the compile time.
+
+  submit_io() and submit_io_batch() fill submission queue entries,
+  a whole batch is passed to the kernel with a single io_uring_enter().
+
+  IO on buffers registered with register_buffers() is done with the
+  "fixed" read and write operations, so that the kernel does not
+  need to map and pin the user pages on every IO.
+
+  There is a single thread, that waits for completions, reaps all
+  available completion queue entries at once, and forwards io completion
+  callbacks to the worker threadpool.
+*/
+namespace tpool
+{
+
+class aio_uring final : public aio
+{
+  thread_pool *m_pool;
+  io_uring m_uring;
+  /** Protects the submission queue and m_buffers */
+  std::mutex m_mutex;
+  /** Registered buffers, sorted by address */
+  std::vector<iovec> m_buffers;
+  bool m_in_shutdown;
+  std::thread m_thread;
+
+  /** Maximum length of a single registered buffer */
+  static constexpr size_t MAX_BUFFER_LEN= size_t{1} << 30;
+  /** Maximum number of completions reaped at once */
+  static constexpr unsigned MAX_EVENTS= 256;
+
+  static void thread_routine(aio_uring *aio)
+  {
+    io_uring_cqe *cqes[MAX_EVENTS];
+    for (;;)
+    {
+      io_uring_cqe *cqe;
+      int ret= io_uring_wait_cqe(&aio->m_uring, &cqe);
+      switch (ret)
+      {
+      case 0:
+        break;
+      case -EINTR:
+      case -EAGAIN:
+        continue;
+      default:
+        fprintf(stderr, "io_uring_wait_cqe() returned %d\n", ret);
+        abort();
+      }
+
+      unsigned n= io_uring_peek_batch_cqe(&aio->m_uring, cqes, MAX_EVENTS);
+      for (unsigned i= 0; i < n; i++)
+      {
+        aiocb *cb= static_cast<aiocb*>(io_uring_cqe_get_data(cqes[i]));
+        if (!cb)
+        {
+          /* The no-op submitted by the destructor */
+          aio->m_in_shutdown= true;
+          continue;
+        }
+
+        int res= cqes[i]->res;
+        if (res < 0)
+        {
+          cb->m_err= -res;
+          cb->m_ret_len= 0;
+        }
+        else
+        {
+          cb->m_ret_len= res;
+          cb->m_err= 0;
+        }
+
+        cb->m_internal_task.m_func= cb->m_callback;
+        cb->m_internal_task.m_arg= cb;
+        cb->m_internal_task.m_group= cb->m_group;
+        aio->m_pool->submit_task(&cb->m_internal_task);
+      }
+      io_uring_cq_advance(&aio->m_uring, n);
+
+      if (aio->m_in_shutdown)
+        break;
+    }
+  }
+
+  /**
+    Find the registered buffer that contains the IO buffer.
+    @return index of the registered buffer, or -1
+  */
+  int find_buffer(const void *buf, size_t len) const
+  {
+    auto it= std::upper_bound(m_buffers.begin(), m_buffers.end(), buf,
+                              [](const void *b, const iovec &v)
+                              { return b < v.iov_base; });
+    if (it == m_buffers.begin())
+      return -1;
+    --it;
+    const char *start= static_cast<const char*>(it->iov_base);
+    if (static_cast<const char*>(buf) + len > start + it->iov_len)
+      return -1;
+    return int(it - m_buffers.begin());
+  }
+
+  /**
+    Get a free submission queue entry.
+    Must be called while holding m_mutex.
+  */
+  io_uring_sqe *get_sqe()
+  {
+    for (;;)
+    {
+      if (io_uring_sqe *sqe= io_uring_get_sqe(&m_uring))
+        return sqe;
+      /* The submission queue is full. Hand over the
+      pending entries to the kernel to make room. */
+      enter();
+    }
+  }
+
+  /**
+    Pass the prepared submission queue entries to the kernel.
+    Must be called while holding m_mutex.
+
+    The entries stay in the submission queue if io_uring_submit()
+    fails, so they cannot be reported back to the caller as failed.
+    Transient errors are retried, anything else is fatal.
+  */
+  void enter()
+  {
+    for (;;)
+    {
+      int ret= io_uring_submit(&m_uring);
+      if (ret >= 0)
+        return;
+      switch (ret)
+      {
+      case -EINTR:
+        continue;
+      case -EAGAIN:
+      case -EBUSY:
+        usleep(1000);
+        continue;
+      default:
+        fprintf(stderr, "io_uring_submit() returned %d\n", ret);
+        abort();
+      }
+    }
+  }
+
+  /** Prepare a submission queue entry. Must be called while holding m_mutex */
+  void prepare(aiocb *cb)
+  {
+    io_uring_sqe *sqe= get_sqe();
+    int index= find_buffer(cb->m_buffer, cb->m_len);
+
+    if (cb->m_opcode == aio_opcode::AIO_PREAD)
+    {
+      if (index < 0)
+        io_uring_prep_read(sqe, cb->m_fh, cb->m_buffer, cb->m_len,
+                           cb->m_offset);
+      else
+        io_uring_prep_read_fixed(sqe, cb->m_fh, cb->m_buffer, cb->m_len,
+                                 cb->m_offset, index);
+    }
+    else
+    {
+      if (index < 0)
+        io_uring_prep_write(sqe, cb->m_fh, cb->m_buffer, cb->m_len,
+                            cb->m_offset);
+      else
+        io_uring_prep_write_fixed(sqe, cb->m_fh, cb->m_buffer, cb->m_len,
+                                  cb->m_offset, index);
+    }
+    io_uring_sqe_set_data(sqe, cb);
+  }
+
+public:
+  aio_uring(thread_pool *pool, const io_uring &uring)
+    : m_pool(pool), m_uring(uring), m_in_shutdown(),
+    m_thread(thread_routine, this)
+  {
+  }
+
+  ~aio_uring()
+  {
+    {
+      std::lock_guard<std::mutex> lk(m_mutex);
+      io_uring_sqe *sqe= get_sqe();
+      io_uring_prep_nop(sqe);
+      io_uring_sqe_set_data(sqe, nullptr);
+      enter();
+    }
+    m_thread.join();
+    io_uring_queue_exit(&m_uring);
+  }
+
+  // Inherited via aio
+  int submit_io(aiocb *cb) override
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    prepare(cb);
+    enter();
+    return 0;
+  }
+
+  size_t submit_io_batch(aiocb **cbs, size_t n) override
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    for (size_t i= 0; i < n; i++)
+      prepare(cbs[i]);
+    enter();
+    return n;
+  }
+
+  int bind(native_file_handle &) override { return 0; }
+  int unbind(const native_file_handle &) override { return 0; }
+
+  int register_buffers(void *const *bufs, const size_t *lens,
+                       size_t n) override
+  {
+    std::vector<iovec> buffers;
+    for (size_t i= 0; i < n; i++)
+    {
+      /* The kernel limits the size of a single registered buffer. */
+      char *buf= static_cast<char*>(bufs[i]);
+      for (size_t len= lens[i]; len; )
+      {
+        size_t l= std::min(len, MAX_BUFFER_LEN);
+        buffers.push_back({buf, l});
+        buf+= l;
+        len-= l;
+      }
+    }
+    std::sort(buffers.begin(), buffers.end(),
+              [](const iovec &a, const iovec &b)
+              { return a.iov_base < b.iov_base; });
+
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (!m_buffers.empty())
+    {
+      io_uring_unregister_buffers(&m_uring);
+      m_buffers.clear();
+    }
+    if (buffers.empty())
+      return 0;
+    int ret= io_uring_register_buffers(&m_uring, buffers.data(),
+                                       unsigned(buffers.size()));
+    if (ret)
+      return -ret;
+    m_buffers.swap(buffers);
+    return 0;
+  }
+
+  void unregister_buffers() override
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (!m_buffers.empty())
+    {
+      io_uring_unregister_buffers(&m_uring);
+      m_buffers.clear();
+    }
+  }
+};
+
+aio *create_linux_io_uring(thread_pool *pool, int max_io)
+{
+  /* IORING_OP_READ and IORING_OP_WRITE require Linux 5.6 */
+  io_uring_probe *probe= io_uring_get_probe();
+  if (!probe)
+    return nullptr;
+  bool supported= io_uring_opcode_supported(probe, IORING_OP_READ) &&
+    io_uring_opcode_supported(probe, IORING_OP_WRITE);
+  io_uring_free_probe(probe);
+  if (!supported)
+    return nullptr;
+
+  io_uring uring;
+  int ret= io_uring_queue_init(max_io, &uring, 0);
+  if (ret)
+  {
+    fprintf(stderr, "io_uring_queue_init(%d) returned %d\n", max_io, ret);
+    return nullptr;
+  }
+  return new aio_uring(pool, uring);
+}
+
+}
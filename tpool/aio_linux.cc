@@ -124,6 +124,36 @@ class aio_linux : public aio
     return -1;
   }
 
+  // Inherited via aio
+  virtual size_t submit_io_batch(aiocb** cbs, size_t n) override
+  {
+    for (size_t i = 0; i < n; i++)
+    {
+      aiocb* cb = cbs[i];
+      if (cb->m_opcode == aio_opcode::AIO_PREAD)
+        io_prep_pread((iocb *)cb, cb->m_fh, cb->m_buffer, cb->m_len,
+          cb->m_offset);
+      else
+        io_prep_pwrite((iocb *)cb, cb->m_fh, cb->m_buffer, cb->m_len,
+          cb->m_offset);
+    }
+
+    /* io_submit() may accept only a part of the batch. */
+    size_t submitted = 0;
+    while (submitted < n)
+    {
+      int ret = io_submit(m_io_ctx, long(n - submitted),
+                          (iocb * *)(cbs + submitted));
+      if (ret <= 0)
+      {
+        errno = ret ? -ret : EAGAIN;
+        break;
+      }
+      submitted += ret;
+    }
+    return submitted;
+  }
+
   // Inherited via aio
   virtual int bind(native_file_handle& fd) override
   {
@@ -18,6 +18,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02111 - 1301 USA*/
 #include <condition_variable>
 #include <mutex>
 #include <atomic>
+#include <errno.h>
 #include <tpool_structs.h>
 #ifdef LINUX_NATIVE_AIO
 #include <libaio.h>
@@ -156,13 +157,49 @@ class aio
     On completion, cb->m_callback is executed.
   */
   virtual int submit_io(aiocb *cb)= 0;
+  /**
+    Submit several asyncronous IOs at once.
+    @return number of submitted IOs. If it is less than n,
+    errno is set, and the remaining IOs were not submitted.
+  */
+  virtual size_t submit_io_batch(aiocb **cbs, size_t n)
+  {
+    size_t i= 0;
+    while (i < n && !submit_io(cbs[i]))
+      i++;
+    return i;
+  }
   /** "Bind" file to AIO handler (used on Windows only) */
   virtual int bind(native_file_handle &fd)= 0;
   /** "Unind" file to AIO handler (used on Windows only) */
   virtual int unbind(const native_file_handle &fd)= 0;
+  /**
+    Register memory areas that will be used as IO buffers, so that
+    the implementation can map them once instead of on every IO
+    (used with io_uring only). Replaces previously registered buffers.
+    @return 0 on success, or error code.
+  */
+  virtual int register_buffers(void *const *bufs, const size_t *lens,
+                               size_t n)
+  {
+    return ENOTSUP;
+  }
+  /** Forget buffers registered by register_buffers() */
+  virtual void unregister_buffers() {}
   virtual ~aio(){};
 };
 
+/** Native AIO implementations (relevant on Linux only) */
+enum class aio_implementation
+{
+  /** io_uring if available, otherwise libaio */
+  AUTO,
+  /** io_uring only; create_native_aio() fails if it is not available */
+  IO_URING,
+  /** libaio */
+  LINUX_AIO
+};
+
 class timer
 {
 public:
@@ -192,7 +229,7 @@ class thread_pool
 protected:
   /* AIO handler */
   std::unique_ptr<aio> m_aio;
-  virtual aio *create_native_aio(int max_io)= 0;
+  virtual aio *create_native_aio(int max_io, aio_implementation impl)= 0;
 
   /**
     Functions to be called at worker thread start/end
@@ -212,11 +249,12 @@ class thread_pool
     m_worker_init_callback= init;
     m_worker_destroy_callback= destroy;
   }
-  int configure_aio(bool use_native_aio, int max_io)
+  int configure_aio(bool use_native_aio, int max_io,
+                    aio_implementation impl= aio_implementation::AUTO)
   {
     if (use_native_aio)
-      m_aio.reset(create_native_aio(max_io));
-    if (!m_aio)
+      m_aio.reset(create_native_aio(max_io, impl));
+    else
       m_aio.reset(create_simulated_aio(this));
     return !m_aio ? -1 : 0;
   }
@@ -227,6 +265,19 @@ class thread_pool
   int bind(native_file_handle &fd) { return m_aio->bind(fd); }
   void unbind(const native_file_handle &fd) { m_aio->unbind(fd); }
   int submit_io(aiocb *cb) { return m_aio->submit_io(cb); }
+  size_t submit_io_batch(aiocb **cbs, size_t n)
+  {
+    return m_aio->submit_io_batch(cbs, n);
+  }
+  int register_buffers(void *const *bufs, const size_t *lens, size_t n)
+  {
+    return m_aio ? m_aio->register_buffers(bufs, lens, n) : ENOTSUP;
+  }
+  void unregister_buffers()
+  {
+    if (m_aio)
+      m_aio->unregister_buffers();
+  }
   virtual void wait_begin() {};
   virtual void wait_end() {};
   virtual ~thread_pool() {}
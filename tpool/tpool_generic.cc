@@ -39,6 +39,9 @@ namespace tpool
 
 #ifdef __linux__
   extern aio* create_linux_aio(thread_pool* tp, int max_io);
+# ifdef HAVE_URING
+  extern aio* create_linux_io_uring(thread_pool* tp, int max_io);
+# endif
 #endif
 #ifdef _WIN32
   extern aio* create_win_aio(thread_pool* tp, int max_io);
@@ -263,11 +266,19 @@ class thread_pool_generic : public thread_pool
   void wait_begin() override;
   void wait_end() override;
   void submit_task(task *task) override;
-  virtual aio *create_native_aio(int max_io) override
+  virtual aio *create_native_aio(int max_io, aio_implementation impl) override
   {
 #ifdef _WIN32
     return create_win_aio(this, max_io);
 #elif defined(__linux__)
+# ifdef HAVE_URING
+    if (impl != aio_implementation::LINUX_AIO)
+    {
+      aio *res= create_linux_io_uring(this, max_io);
+      if (res || impl == aio_implementation::IO_URING)
+        return res;
+    }
+# endif
     return create_linux_aio(this,max_io);
 #else
     return nullptr;
@@ -0,0 +1,87 @@
+/* Copyright (c) 2020, MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+/**
+  @file
+
+  Unit tests for the radix sorts of pointers to fixed length strings
+*/
+
+#include <my_global.h>
+#include <my_sys.h>
+#include "tap.h"
+
+/*
+  Sort n strings of the given size whose first 'prefix' bytes are the same
+  and the other bytes are random values below 'alphabet'.
+*/
+static void test_msd_radixsort(uint n, size_t size, size_t prefix,
+                               uint alphabet)
+{
+  uchar *data= (uchar*) my_malloc(n * size, MYF(MY_WME));
+  uchar **keys= (uchar**) my_malloc(n * sizeof(uchar*), MYF(MY_WME));
+  uchar **buffer= (uchar**) my_malloc(n * sizeof(uchar*), MYF(MY_WME));
+  uchar *digits= (uchar*) my_malloc(n, MYF(MY_WME));
+  uchar *seen= (uchar*) my_malloc(n, MYF(MY_WME | MY_ZEROFILL));
+  my_bool sorted= TRUE, permutation= TRUE;
+  uint i;
+  size_t j;
+
+  for (i= 0; i < n; i++)
+  {
+    keys[i]= data + i * size;
+    for (j= 0; j < size; j++)
+      keys[i][j]= j < prefix ? 'a' : (uchar) (rand() % alphabet);
+  }
+
+  msd_radixsort_for_str_ptr(keys, n, size, buffer, digits);
+
+  for (i= 1; i < n; i++)
+    if (memcmp(keys[i-1], keys[i], size) > 0)
+      sorted= FALSE;
+  for (i= 0; i < n; i++)
+  {
+    size_t idx= (keys[i] - data) / size;
+    if (seen[idx]++)
+      permutation= FALSE;
+  }
+  ok(sorted && permutation,
+     "msd_radixsort_for_str_ptr n: %u size: %u prefix: %u alphabet: %u",
+     n, (uint) size, (uint) prefix, alphabet);
+
+  my_free(seen);
+  my_free(digits);
+  my_free(buffer);
+  my_free(keys);
+  my_free(data);
+}
+
+
+int main(int argc __attribute__((unused)),char *argv[])
+{
+  MY_INIT(argv[0]);
+
+  plan(6);
+
+  test_msd_radixsort(1000, 4, 0, 256);
+  test_msd_radixsort(100000, 8, 0, 256);
+  test_msd_radixsort(100000, 40, 30, 256);
+  test_msd_radixsort(50000, 16, 0, 2);
+  test_msd_radixsort(50000, 100, 0, 1);
+  test_msd_radixsort(5000, 1, 0, 256);
+
+  my_end(0);
+  return exit_status();
+}